@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "../comum/escritorRapido.h" // Saída com buffer e conversão manual de inteiros
 
 
 //-------[ Estruturas ]-------
@@ -49,11 +50,13 @@ int main(int argc, char **argv){
 //--------------------[ Funcao de processamento do input ]--------------------
 void processarDocumentos(char *input, char *output){
     FILE *arqInput = fopen(input, "r");
-    FILE *arqOutput = fopen(output, "w");
-    if(!arqInput || !arqOutput){
+    EscritorRapido saida;
+    int saidaAberta = abrirEscritor(&saida, output);
+    EscritorRapido *arqOutput = &saida;
+    if(!arqInput || !saidaAberta){
         printf("Erro ao abrir os arquivos\n");
         if(arqInput) fclose(arqInput);
-        if(arqOutput) fclose(arqOutput);
+        if(saidaAberta) fecharEscritor(arqOutput);
         return;
     }
 
@@ -77,7 +80,7 @@ void processarDocumentos(char *input, char *output){
     if(fscanf(arqInput, "%d", &qtdContaineresCadastrados) != 1){
         printf("Erro ao ler a quantidade de containers cadastrados\n");
         fclose(arqInput);
-        fclose(arqOutput);
+        fecharEscritor(arqOutput);
     }
 
     containers = (Container *)malloc(qtdContaineresCadastrados * sizeof(Container));
@@ -86,7 +89,7 @@ void processarDocumentos(char *input, char *output){
         if(fscanf(arqInput, "%s %s %d", codigo, cnpj, &pesoContainer) != 3){
             printf("Erro ao ler os dados do container %d\n", i+1);
             fclose(arqInput);
-            fclose(arqOutput);
+            fecharEscritor(arqOutput);
         }
         strcpy(containers[i].codigo, codigo);
         strcpy(containers[i].cnpj, cnpj);
@@ -100,14 +103,14 @@ void processarDocumentos(char *input, char *output){
     if(fscanf(arqInput, "%d", &qtdInspecaoConteineres) != 1){
         printf("Erro ao ler a quantidade de inspecões de containers\n");
         fclose(arqInput);
-        fclose(arqOutput);
+        fecharEscritor(arqOutput);
     }
 
     for(int i = 0; i < qtdInspecaoConteineres; i++){
         if(fscanf(arqInput, "%s %s %d", codigo, cnpj, &pesoContainer) != 3){
             printf("Erro ao ler os dados da inspecão do container %d\n", i+1);
             fclose(arqInput);
-            fclose(arqOutput);
+            fecharEscritor(arqOutput);
         }
         posicaoContainer = buscaBinaria(containers, 0, qtdContaineresCadastrados - 1, codigo);
         if(posicaoContainer == -1){
@@ -132,7 +135,12 @@ void processarDocumentos(char *input, char *output){
     FilaContainerCNPJ *auxCNPJ = filaCNPJ;
   while (auxCNPJ != NULL) {
       if (auxCNPJ->container != NULL) {
-          fprintf(arqOutput, "%s:%s<->%s\n", auxCNPJ->container->codigo, auxCNPJ->container->cnpj, auxCNPJ->cnpj);
+          escreverTexto(arqOutput, auxCNPJ->container->codigo);
+          escreverCaractere(arqOutput, ':');
+          escreverTexto(arqOutput, auxCNPJ->container->cnpj);
+          escreverTexto(arqOutput, "<->");
+          escreverTexto(arqOutput, auxCNPJ->cnpj);
+          escreverCaractere(arqOutput, '\n');
       }
       auxCNPJ = auxCNPJ->ProxContainer;
   }
@@ -140,7 +148,12 @@ void processarDocumentos(char *input, char *output){
 
     FilaContainerPeso *auxPeso = filaPeso;
     while (auxPeso != NULL) {
-        fprintf(arqOutput, "%s:%dkg(%d%%)\n", auxPeso->container->codigo, auxPeso->diferencaPeso, auxPeso->porcentagemPeso);
+        escreverTexto(arqOutput, auxPeso->container->codigo);
+        escreverCaractere(arqOutput, ':');
+        escreverInteiro(arqOutput, auxPeso->diferencaPeso);
+        escreverTexto(arqOutput, "kg(");
+        escreverInteiro(arqOutput, auxPeso->porcentagemPeso);
+        escreverTexto(arqOutput, "%)\n");
         auxPeso = auxPeso->ProxContainer;
     }
 
@@ -148,7 +161,7 @@ void processarDocumentos(char *input, char *output){
     liberarFilaPeso(filaPeso);
 
     fclose(arqInput);
-    fclose(arqOutput);
+    fecharEscritor(arqOutput);
     free(containers);
 }
 
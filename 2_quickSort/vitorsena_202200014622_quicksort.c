@@ -1,48 +1,149 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <math.h>  // Para usar ceil()
-
-int contagemTrocas = 0;  // Contador de trocas
-int contagemChamadas = 0; // Contador de chamadas
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>  // sysconf, read, close
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>  // __rdtsc()
+#endif
+#ifdef __linux__
+#include <linux/perf_event.h>  // Contadores de hardware (opção -perf)
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#include "../comum/leitorRapido.h"  // Leitura rápida de inteiros (mmap + conversão manual)
+#include "../comum/escritorRapido.h"  // Saída com buffer e conversão manual de inteiros
+// Compilar - gcc -o vitorsena_202200014622_quicksort vitorsena_202200014622_quicksort.c -pthread
+
+#define MAXIMO_ALGORITMOS 16               // Capacidade do registro de algoritmos
+#define MAXIMO_SUBINTERVALOS 4             // Três pivôs dividem o intervalo em quatro partes
+#define MAXIMO_REDE_ORDENACAO 16           // Maior intervalo ordenado por rede de ordenação
+#define LIMITE_THREADS 8         // Número máximo de threads trabalhadoras
+#define LISTAS_POR_LOTE 64       // Listas lidas e ordenadas em paralelo de cada vez
+
+// Os contadores são locais a cada thread, assim cada variante conta apenas as próprias operações
+_Thread_local int contagemTrocas = 0;  // Contador de trocas
+_Thread_local int contagemChamadas = 0; // Contador de chamadas
+_Thread_local long long contagemComparacoes = 0; // Comparações entre elementos (não entram em operacoesTotais)
+
+// Conta uma comparação entre elementos e devolve o seu resultado
+#define comparar(condicao) (contagemComparacoes++, (condicao))
+
+// Contadores de hardware medidos com -perf
+#define QUANTIDADE_CONTADORES_HARDWARE 3  // Instruções, desvios mal previstos e falhas de cache
 
 typedef struct EstatisticasAlgoritmo {
     int operacoesTotais;
-    char siglaAlgoritmo[3];
+    int chamadas;
+    int idAlgoritmo;               // Posição da variante em registroAlgoritmos
+    int prioridade;                // Desempate do ranking, copiado do registro (menor vem primeiro)
+    long long tempoNanossegundos;  // Tempo de parede da execução da variante
+    long long ciclos;              // Ciclos medidos com rdtsc (0 fora de x86)
+    long long comparacoes;
+    long long contadoresHardware[QUANTIDADE_CONTADORES_HARDWARE];  // -1 quando indisponível
 } EstatisticasAlgoritmo;
 
+// Opções do relatório escolhidas na linha de comando
+typedef struct ConfiguracaoRelatorio {
+    int incluirMetricas;      // -metricas: escreve tempo, ciclos e comparações de cada variante
+    int ordenarPorTempo;      // -tempo: classifica pelo tempo de parede em vez das operações
+    int contadoresHardware;   // -perf: lê instruções, desvios e falhas de cache (Linux)
+    int incluirMultiPivo;     // -multipivo: inclui as variantes de múltiplos pivôs do registro
+} ConfiguracaoRelatorio;
+
+ConfiguracaoRelatorio configuracao = {0, 0, 0, 0};
+
+// Variante de quicksort registrada: a ordem do registro é a ordem de execução
+typedef struct AlgoritmoRegistrado {
+    const char *sigla;
+    int prioridade;                    // Desempate do ranking: menor valor vem primeiro
+    void (*ordenar)(int*, int, int);
+    int multiPivo;                     // 1 se só participa com a opção -multipivo
+} AlgoritmoRegistrado;
+
+// Ids (posições em registroAlgoritmos) das variantes que participam desta execução
+int algoritmosAtivos[MAXIMO_ALGORITMOS];
+int quantidadeAlgoritmosAtivos = 0;
+
+// Intervalos com até este tamanho são ordenados por rede de ordenação (0 = desativado, opção -rede)
+int limiteRedeOrdenacao = 0;
+
+// Buffer que só cresce: guarda o tamanho da maior lista já vista e é reaproveitado
+typedef struct BufferCrescente {
+    int *dados;
+    int capacidade;
+} BufferCrescente;
+
+// Uma lista lida da entrada, com as estatísticas de cada variante
+typedef struct Lista {
+    BufferCrescente arrayOriginal;  // Reaproveitado pelas listas que ocupam esta posição do lote
+    int tamanho;
+    int erroAlocacao;
+    EstatisticasAlgoritmo estatisticas[MAXIMO_ALGORITMOS];
+} Lista;
+
+// Lote de listas compartilhado pelas threads; cada tarefa é um par (lista, variante)
+typedef struct LoteListas {
+    Lista *listas;
+    int quantidade;
+    int proximaTarefa;
+    pthread_mutex_t trava;
+    long long tempoTotal[MAXIMO_ALGORITMOS];  // Soma do tempo de cada variante ativa em todas as listas
+    long long chamadasTotal[MAXIMO_ALGORITMOS];
+    long long operacoesTotal[MAXIMO_ALGORITMOS];
+    BufferCrescente copias[LIMITE_THREADS];  // Cópia de trabalho de cada thread, reaproveitada entre lotes
+} LoteListas;
+
+// Argumento de cada thread trabalhadora
+typedef struct Trabalhador {
+    LoteListas *lote;
+    BufferCrescente *copia;
+} Trabalhador;
+
+// Garante espaço para 'tamanho' inteiros; só realoca quando a lista é maior que todas as anteriores
+int garantirCapacidade(BufferCrescente *buffer, int tamanho) {
+    if (tamanho <= buffer->capacidade) return 1;
+
+    // O conteúdo antigo não é necessário, então evita a cópia do realloc
+    free(buffer->dados);
+    buffer->dados = malloc(tamanho * sizeof(int));
+    buffer->capacidade = buffer->dados ? tamanho : 0;
+    return buffer->dados != NULL;
+}
+
+void liberarBuffer(BufferCrescente *buffer) {
+    free(buffer->dados);
+    buffer->dados = NULL;
+    buffer->capacidade = 0;
+}
+
 // Função para incrementar o contador de chamadas
 void incrementarChamadas() {
     contagemChamadas++;
 }
 
-// Função para determinar a prioridade de uma sigla
-int obterPrioridade(char *sigla) {
-    if (strcmp(sigla, "LP") == 0) return 1;
-    if (strcmp(sigla, "LM") == 0) return 2;
-    if (strcmp(sigla, "LA") == 0) return 3;
-    if (strcmp(sigla, "HP") == 0) return 4;
-    if (strcmp(sigla, "HM") == 0) return 5;
-    if (strcmp(sigla, "HA") == 0) return 6;
-    return 7; // Sigla desconhecida
-}
-
-// Função para ordenar o array
-void ordenarEstatisticas(EstatisticasAlgoritmo arr[], int n) {
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = 0; j < n - i - 1; j++) {
-            // Primeiro critério: número de trocas e chamadas (crescente)
-            if (arr[j].operacoesTotais > arr[j + 1].operacoesTotais ||
-                // Segundo critério: desempate pela prioridade da sigla (crescente)
-                (arr[j].operacoesTotais == arr[j + 1].operacoesTotais &&
-                 obterPrioridade(arr[j].siglaAlgoritmo) > obterPrioridade(arr[j + 1].siglaAlgoritmo))) {
-                // Troca os elementos
-                EstatisticasAlgoritmo temp = arr[j];
-                arr[j] = arr[j + 1];
-                arr[j + 1] = temp;
-            }
-        }
-    }
+// Critério padrão: operações (chamadas + trocas) crescentes, desempate pela prioridade da sigla
+int compararPorOperacoes(const void *a, const void *b) {
+    const EstatisticasAlgoritmo *x = (const EstatisticasAlgoritmo *)a;
+    const EstatisticasAlgoritmo *y = (const EstatisticasAlgoritmo *)b;
+    if (x->operacoesTotais != y->operacoesTotais) return x->operacoesTotais < y->operacoesTotais ? -1 : 1;
+    return x->prioridade - y->prioridade;
+}
+
+// Critério da opção -tempo: tempo de parede crescente, desempate pela prioridade da sigla
+int compararPorTempo(const void *a, const void *b) {
+    const EstatisticasAlgoritmo *x = (const EstatisticasAlgoritmo *)a;
+    const EstatisticasAlgoritmo *y = (const EstatisticasAlgoritmo *)b;
+    if (x->tempoNanossegundos != y->tempoNanossegundos) return x->tempoNanossegundos < y->tempoNanossegundos ? -1 : 1;
+    return x->prioridade - y->prioridade;
+}
+
+// Função para ordenar o array: O(k log k) sobre chaves inteiras (as prioridades são únicas)
+void ordenarEstatisticas(EstatisticasAlgoritmo arr[], int n, int porTempo) {
+    qsort(arr, n, sizeof(EstatisticasAlgoritmo), porTempo ? compararPorTempo : compararPorOperacoes);
 }
 
 // Função para trocar os valores de dois ponteiros e contar a troca
@@ -81,6 +182,104 @@ int obterMedianaDeTres(int arr[], int baixo, int alto, int ehLomuto) {
     return encontrarMedianaEstavel(arr, idx1, idx2, idx3);
 }
 
+//----------------[ Redes de ordenação para intervalos pequenos ]----------------
+
+/*
+   Redes de ordenação com 4, 8 e 16 entradas (5, 19 e 60 comparadores).
+   Cada comparador é um par (i, j) com i < j; após a rede, v[0..n-1] está ordenado.
+*/
+static const unsigned char redeQuatro[][2] = {
+    {0,1},{2,3},{0,2},{1,3},{1,2}
+};
+static const unsigned char redeOito[][2] = {
+    {0,2},{1,3},{4,6},{5,7},{0,4},{1,5},{2,6},{3,7},{0,1},{2,3},{4,5},{6,7},
+    {2,4},{3,5},{1,4},{3,6},{1,2},{3,4},{5,6}
+};
+static const unsigned char redeDezesseis[][2] = {
+    {0,13},{1,12},{2,15},{3,14},{4,8},{5,6},{7,11},{9,10},
+    {0,5},{1,7},{2,9},{3,4},{6,13},{8,14},{10,15},{11,12},
+    {0,1},{2,3},{4,5},{6,8},{7,9},{10,11},{12,13},{14,15},
+    {0,2},{1,3},{4,10},{5,11},{6,7},{8,9},{12,14},{13,15},
+    {1,2},{3,12},{4,6},{5,7},{8,10},{9,11},{13,14},
+    {1,4},{2,6},{5,8},{7,10},{9,13},{11,14},
+    {2,4},{3,6},{9,12},{11,13},
+    {3,5},{6,8},{7,9},{10,12},
+    {3,4},{5,6},{7,8},{9,10},{11,12},
+    {6,7},{8,9}
+};
+
+// Aplica uma rede; min/max sem desvios (o compilador gera cmov). Retorna quantos pares trocaram de lugar
+static int aplicarRede(int v[], const unsigned char rede[][2], int comparadores) {
+    int trocas = 0;
+    for (int c = 0; c < comparadores; c++) {
+        int a = v[rede[c][0]], b = v[rede[c][1]];
+        int menor = a < b ? a : b;
+        int maior = a < b ? b : a;
+        trocas += (a > b);
+        v[rede[c][0]] = menor;
+        v[rede[c][1]] = maior;
+    }
+    return trocas;
+}
+
+// Ordena arr[baixo..alto] (até MAXIMO_REDE_ORDENACAO elementos) com a menor rede que o comporta
+void ordenarComRede(int arr[], int baixo, int alto) {
+    int n = alto - baixo + 1;
+    int v[MAXIMO_REDE_ORDENACAO];
+
+    // Completa com INT_MAX, que termina no fim e não altera os n primeiros
+    memcpy(v, &arr[baixo], n * sizeof(int));
+    int largura = n <= 4 ? 4 : (n <= 8 ? 8 : 16);
+    for (int k = n; k < largura; k++) v[k] = INT_MAX;
+
+    int trocas;
+    if (largura == 4) {
+        trocas = aplicarRede(v, redeQuatro, sizeof(redeQuatro) / sizeof(redeQuatro[0]));
+        contagemComparacoes += sizeof(redeQuatro) / sizeof(redeQuatro[0]);
+    } else if (largura == 8) {
+        trocas = aplicarRede(v, redeOito, sizeof(redeOito) / sizeof(redeOito[0]));
+        contagemComparacoes += sizeof(redeOito) / sizeof(redeOito[0]);
+    } else {
+        trocas = aplicarRede(v, redeDezesseis, sizeof(redeDezesseis) / sizeof(redeDezesseis[0]));
+        contagemComparacoes += sizeof(redeDezesseis) / sizeof(redeDezesseis[0]);
+    }
+    contagemTrocas += trocas;
+    memcpy(&arr[baixo], v, n * sizeof(int));
+}
+
+//----------------[ Núcleo com profundidade de pilha limitada ]----------------
+
+/*
+   Todas as variantes compartilham este laço: após particionar, a recursão é feita
+   apenas no lado menor e o lado maior continua no próprio laço (eliminação da
+   chamada de cauda). Assim a pilha nunca passa de O(log n), mesmo em listas degeneradas.
+   Cada subintervalo continua contando como uma chamada, então as métricas não mudam.
+   - particionar: função de particionamento da variante.
+   - ehHoare: 1 se o pivô retornado fica no lado esquerdo (Hoare), 0 se fica fora dos dois lados (Lomuto).
+*/
+void quickSortComPilhaLimitada(int arr[], int baixo, int alto, int (*particionar)(int[], int, int), int ehHoare) {
+    incrementarChamadas();  // Incrementa a chamada da função
+
+    while (baixo < alto) {
+        // Caso base: intervalos pequenos vão direto para a rede de ordenação
+        if (alto - baixo < limiteRedeOrdenacao) {
+            ordenarComRede(arr, baixo, alto);
+            break;
+        }
+        int pivo = particionar(arr, baixo, alto);
+        int fimEsquerda = ehHoare ? pivo : pivo - 1;
+
+        if (fimEsquerda - baixo < alto - pivo) {
+            quickSortComPilhaLimitada(arr, baixo, fimEsquerda, particionar, ehHoare);
+            baixo = pivo + 1;
+        } else {
+            quickSortComPilhaLimitada(arr, pivo + 1, alto, particionar, ehHoare);
+            alto = fimEsquerda;
+        }
+        incrementarChamadas();  // O lado maior conta como a chamada que foi eliminada
+    }
+}
+
 //----------------[ Função de particionamento Lomuto ]----------------
 
 int particionarLomuto(int arr[], int baixo, int alto) {
@@ -88,7 +287,7 @@ int particionarLomuto(int arr[], int baixo, int alto) {
     int i = baixo - 1;
 
     for (int j = baixo; j < alto; j++) {
-        if (arr[j] <= pivo)
+        if (comparar(arr[j] <= pivo))
             realizarTroca(&arr[++i], &arr[j]);
     }
     realizarTroca(&arr[++i], &arr[alto]);
@@ -96,13 +295,7 @@ int particionarLomuto(int arr[], int baixo, int alto) {
 }
 
 void quickSortLomuto(int arr[], int baixo, int alto) {
-    incrementarChamadas();  // Incrementa a chamada da função
-
-    if (baixo < alto) {
-        int pivo = particionarLomuto(arr, baixo, alto);
-        quickSortLomuto(arr, baixo, pivo - 1);
-        quickSortLomuto(arr, pivo + 1, alto);
-    }
+    quickSortComPilhaLimitada(arr, baixo, alto, particionarLomuto, 0);
 }
 
 //----------------[ Função de particionamento Lomuto com mediana de três ]----------------
@@ -116,12 +309,7 @@ int particionarMedianaDeTres(int arr[], int baixo, int alto) {
 
 // Função Recursiva de QuickSort com mediana de três
 void quickSortMedianaDeTres(int arr[], int baixo, int alto) {
-    incrementarChamadas();  // Incrementa a chamada da função
-    if (baixo < alto) {
-        int pivo = particionarMedianaDeTres(arr, baixo, alto);
-        quickSortMedianaDeTres(arr, baixo, pivo - 1);
-        quickSortMedianaDeTres(arr, pivo + 1, alto);
-    }
+    quickSortComPilhaLimitada(arr, baixo, alto, particionarMedianaDeTres, 0);
 }
 
 //----------------[ Função de particionamento Lomuto com pivô aleatório ]----------------
@@ -134,13 +322,7 @@ int particionarLomutoAleatorio(int arr[], int baixo, int alto) {
 }
 
 void quickSortLomutoAleatorio(int arr[], int baixo, int alto) {
-    incrementarChamadas();  // Incrementa a chamada da função
-
-    if (baixo < alto) {
-        int pivo = particionarLomutoAleatorio(arr, baixo, alto);
-        quickSortLomutoAleatorio(arr, baixo, pivo - 1);
-        quickSortLomutoAleatorio(arr, pivo + 1, alto);
-    }
+    quickSortComPilhaLimitada(arr, baixo, alto, particionarLomutoAleatorio, 0);
 }
 
 //----------------[ Função de particionamento Hoare ]----------------
@@ -151,8 +333,8 @@ int particionarHoare(int arr[], int baixo, int alto) {
     int j = alto + 1;
 
     while (1) {
-        while (arr[--j] > pivo);  // Encontra o elemento menor que o pivô
-        while (arr[++i] < pivo);  // Encontra o elemento maior que o pivô
+        while (comparar(arr[--j] > pivo));  // Encontra o elemento menor que o pivô
+        while (comparar(arr[++i] < pivo));  // Encontra o elemento maior que o pivô
 
         if (i < j) {
             realizarTroca(&arr[i], &arr[j]);
@@ -163,13 +345,7 @@ int particionarHoare(int arr[], int baixo, int alto) {
 }
 
 void quickSortHoare(int arr[], int baixo, int alto) {
-    incrementarChamadas();  // Incrementa a chamada da função
-
-    if (baixo < alto) {
-        int pivo = particionarHoare(arr, baixo, alto);
-        quickSortHoare(arr, baixo, pivo);
-        quickSortHoare(arr, pivo + 1, alto);
-    }
+    quickSortComPilhaLimitada(arr, baixo, alto, particionarHoare, 1);
 }
 
 //----------------[ Função de particionamento Hoare com mediana de três ]----------------
@@ -182,11 +358,11 @@ int particionarHoareV2(int arr[], int baixo, int alto) {
     while (1) {
         do {
             i++;
-        } while (arr[i] < pivo);
+        } while (comparar(arr[i] < pivo));
 
         do {
             j--;
-        } while (arr[j] > pivo);
+        } while (comparar(arr[j] > pivo));
 
         if (i >= j) {
             return j;
@@ -202,12 +378,7 @@ int particionarHoareMedianaDeTres(int arr[], int baixo, int alto) {
 }
 
 void quickSortHoareMediana(int arr[], int baixo, int alto) {
-    incrementarChamadas();
-    if (baixo < alto) {
-        int pivo = particionarHoareMedianaDeTres(arr, baixo, alto);
-        quickSortHoareMediana(arr, baixo, pivo);
-        quickSortHoareMediana(arr, pivo + 1, alto);
-    }
+    quickSortComPilhaLimitada(arr, baixo, alto, particionarHoareMedianaDeTres, 1);
 }
 
 //----------------[ Função de particionamento Hoare com pivô aleatório ]----------------
@@ -220,144 +391,516 @@ int particionarHoareAleatorio(int arr[], int baixo, int alto) {
 }
 
 void quickSortHoareAleatorio(int arr[], int baixo, int alto) {
+    quickSortComPilhaLimitada(arr, baixo, alto, particionarHoareAleatorio, 1);
+}
+
+//----------------[ Núcleo para múltiplos pivôs ]----------------
+
+/*
+   Mesmo princípio do quickSortComPilhaLimitada, mas a partição devolve até
+   MAXIMO_SUBINTERVALOS subintervalos [inicio, fim]. A recursão é feita em todos
+   menos o maior, que continua no laço; cada subintervalo conta como uma chamada.
+   A partição devolve 0 quando ordena o intervalo diretamente.
+*/
+void quickSortMultiPivo(int arr[], int baixo, int alto, int (*particionar)(int[], int, int, int[][2])) {
     incrementarChamadas();  // Incrementa a chamada da função
 
-    if (baixo < alto) {
-        int pivo = particionarHoareAleatorio(arr, baixo, alto);
-        quickSortHoareAleatorio(arr, baixo, pivo);
-        quickSortHoareAleatorio(arr, pivo + 1, alto);
+    while (baixo < alto) {
+        if (alto - baixo < limiteRedeOrdenacao) {
+            ordenarComRede(arr, baixo, alto);
+            break;
+        }
+        int subintervalos[MAXIMO_SUBINTERVALOS][2];
+        int quantidade = particionar(arr, baixo, alto, subintervalos);
+        if (quantidade == 0) break;
+
+        int maior = 0;
+        for (int s = 1; s < quantidade; s++) {
+            if (subintervalos[s][1] - subintervalos[s][0] > subintervalos[maior][1] - subintervalos[maior][0])
+                maior = s;
+        }
+        for (int s = 0; s < quantidade; s++) {
+            if (s != maior)
+                quickSortMultiPivo(arr, subintervalos[s][0], subintervalos[s][1], particionar);
+        }
+        baixo = subintervalos[maior][0];
+        alto = subintervalos[maior][1];
+        incrementarChamadas();  // O maior subintervalo conta como a chamada que foi eliminada
+    }
+}
+
+//----------------[ Função de particionamento com dois pivôs (Yaroslavskiy) ]----------------
+
+// Pivôs p <= q nas extremidades; divide em < p, entre p e q, e >= q
+int particionarDoisPivos(int arr[], int baixo, int alto, int subintervalos[][2]) {
+    if (comparar(arr[baixo] > arr[alto])) realizarTroca(&arr[baixo], &arr[alto]);
+    int pivoEsquerdo = arr[baixo], pivoDireito = arr[alto];
+    int menores = baixo + 1, maiores = alto - 1;
+
+    for (int k = menores; k <= maiores; k++) {
+        if (comparar(arr[k] < pivoEsquerdo)) {
+            realizarTroca(&arr[k], &arr[menores++]);
+        } else if (comparar(arr[k] >= pivoDireito)) {
+            while (comparar(arr[maiores] > pivoDireito) && k < maiores) maiores--;
+            realizarTroca(&arr[k], &arr[maiores--]);
+            if (comparar(arr[k] < pivoEsquerdo)) realizarTroca(&arr[k], &arr[menores++]);
+        }
+    }
+    menores--;
+    maiores++;
+    realizarTroca(&arr[baixo], &arr[menores]);
+    realizarTroca(&arr[alto], &arr[maiores]);
+
+    subintervalos[0][0] = baixo;        subintervalos[0][1] = menores - 1;
+    subintervalos[1][0] = menores + 1;  subintervalos[1][1] = maiores - 1;
+    subintervalos[2][0] = maiores + 1;  subintervalos[2][1] = alto;
+    return 3;
+}
+
+void quickSortDoisPivos(int arr[], int baixo, int alto) {
+    quickSortMultiPivo(arr, baixo, alto, particionarDoisPivos);
+}
+
+//----------------[ Função de particionamento com três pivôs (Kushagra et al.) ]----------------
+
+// Pivôs p <= q <= r em arr[baixo], arr[baixo + 1] e arr[alto]; divide em quatro faixas
+int particionarTresPivos(int arr[], int baixo, int alto, int subintervalos[][2]) {
+    // Com menos de três elementos não há pivôs suficientes: ordena diretamente
+    if (alto - baixo < 2) {
+        if (comparar(arr[baixo] > arr[alto])) realizarTroca(&arr[baixo], &arr[alto]);
+        return 0;
+    }
+
+    // Ordena os três pivôs
+    if (comparar(arr[baixo] > arr[baixo + 1])) realizarTroca(&arr[baixo], &arr[baixo + 1]);
+    if (comparar(arr[baixo + 1] > arr[alto])) realizarTroca(&arr[baixo + 1], &arr[alto]);
+    if (comparar(arr[baixo] > arr[baixo + 1])) realizarTroca(&arr[baixo], &arr[baixo + 1]);
+    int p = arr[baixo], q = arr[baixo + 1], r = arr[alto];
+
+    // [baixo+2, a) < p <= [a, b) < q,  q < (c, d] <= r < (d, alto-1]
+    int a = baixo + 2, b = baixo + 2;
+    int c = alto - 1, d = alto - 1;
+    while (b <= c) {
+        while (b <= c && comparar(arr[b] < q)) {
+            if (comparar(arr[b] < p)) realizarTroca(&arr[a++], &arr[b]);
+            b++;
+        }
+        while (b <= c && comparar(arr[c] > q)) {
+            if (comparar(arr[c] > r)) realizarTroca(&arr[c], &arr[d--]);
+            c--;
+        }
+        if (b <= c) {
+            int vaiParaDireita = comparar(arr[b] > r);
+            if (comparar(arr[c] < p)) {
+                realizarTroca(&arr[b], &arr[a]);
+                realizarTroca(&arr[a++], &arr[c]);
+            } else {
+                realizarTroca(&arr[b], &arr[c]);
+            }
+            if (vaiParaDireita) realizarTroca(&arr[c], &arr[d--]);
+            b++;
+            c--;
+        }
+    }
+    a--; b--; c++; d++;
+    realizarTroca(&arr[baixo + 1], &arr[a]);
+    realizarTroca(&arr[a--], &arr[b]);
+    realizarTroca(&arr[baixo], &arr[a]);
+    realizarTroca(&arr[alto], &arr[d]);
+
+    subintervalos[0][0] = baixo;  subintervalos[0][1] = a - 1;
+    subintervalos[1][0] = a + 1;  subintervalos[1][1] = b - 1;
+    subintervalos[2][0] = b + 1;  subintervalos[2][1] = d - 1;
+    subintervalos[3][0] = d + 1;  subintervalos[3][1] = alto;
+    return 4;
+}
+
+void quickSortTresPivos(int arr[], int baixo, int alto) {
+    quickSortMultiPivo(arr, baixo, alto, particionarTresPivos);
+}
+
+// Tempo monotônico em nanossegundos
+long long obterTempoNanossegundos() {
+    struct timespec instante;
+    clock_gettime(CLOCK_MONOTONIC, &instante);
+    return (long long)instante.tv_sec * 1000000000LL + instante.tv_nsec;
+}
+
+// Contador de ciclos do processador (0 quando não há rdtsc)
+long long obterCiclos() {
+#if defined(__x86_64__) || defined(__i386__)
+    return (long long)__rdtsc();
+#else
+    return 0;
+#endif
+}
+
+//----------------[ Contadores de hardware (perf_event, opção -perf) ]----------------
+
+// Descritores abertos por cada thread trabalhadora; -1 quando o contador não está disponível
+_Thread_local int descritoresHardware[QUANTIDADE_CONTADORES_HARDWARE] = {-1, -1, -1};
+_Thread_local int contadoresAbertos = 0;
+
+void iniciarContadoresHardware() {
+#ifdef __linux__
+    static const unsigned long long eventos[QUANTIDADE_CONTADORES_HARDWARE] = {
+        PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES
+    };
+    if (!contadoresAbertos) {
+        for (int c = 0; c < QUANTIDADE_CONTADORES_HARDWARE; c++) {
+            struct perf_event_attr atributos;
+            memset(&atributos, 0, sizeof(atributos));
+            atributos.type = PERF_TYPE_HARDWARE;
+            atributos.size = sizeof(atributos);
+            atributos.config = eventos[c];
+            atributos.disabled = 1;
+            atributos.exclude_kernel = 1;
+            atributos.exclude_hv = 1;
+            // pid 0 e cpu -1: mede apenas a thread atual, em qualquer núcleo
+            descritoresHardware[c] = (int)syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0);
+        }
+        contadoresAbertos = 1;
+    }
+    for (int c = 0; c < QUANTIDADE_CONTADORES_HARDWARE; c++) {
+        if (descritoresHardware[c] >= 0) {
+            ioctl(descritoresHardware[c], PERF_EVENT_IOC_RESET, 0);
+            ioctl(descritoresHardware[c], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+void pararContadoresHardware(long long valores[]) {
+    for (int c = 0; c < QUANTIDADE_CONTADORES_HARDWARE; c++) {
+        valores[c] = -1;
+#ifdef __linux__
+        long long lido;
+        if (descritoresHardware[c] >= 0) {
+            ioctl(descritoresHardware[c], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(descritoresHardware[c], &lido, sizeof(lido)) == sizeof(lido)) valores[c] = lido;
+        }
+#endif
+    }
+}
+
+void fecharContadoresHardware() {
+#ifdef __linux__
+    for (int c = 0; c < QUANTIDADE_CONTADORES_HARDWARE; c++) {
+        if (descritoresHardware[c] >= 0) close(descritoresHardware[c]);
+        descritoresHardware[c] = -1;
+    }
+#endif
+    contadoresAbertos = 0;
+}
+
+/*
+   Registro das variantes. Para adicionar uma nova basta incluí-la aqui:
+   a execução, o ranking e o relatório percorrem este vetor.
+   critérios de desempate: LP > LM > LA > HP > HM > HA > DP > TP (menor prioridade primeiro).
+*/
+const AlgoritmoRegistrado registroAlgoritmos[] = {
+    {"LP", 1, quickSortLomuto,          0},
+    {"LM", 2, quickSortMedianaDeTres,   0},
+    {"LA", 3, quickSortLomutoAleatorio, 0},
+    {"HP", 4, quickSortHoare,           0},
+    {"HM", 5, quickSortHoareMediana,    0},
+    {"HA", 6, quickSortHoareAleatorio,  0},
+    {"DP", 7, quickSortDoisPivos,       1},
+    {"TP", 8, quickSortTresPivos,       1},
+};
+#define QUANTIDADE_REGISTRADOS ((int)(sizeof(registroAlgoritmos) / sizeof(registroAlgoritmos[0])))
+_Static_assert(sizeof(registroAlgoritmos) / sizeof(registroAlgoritmos[0]) <= MAXIMO_ALGORITMOS,
+               "Aumente MAXIMO_ALGORITMOS");
+
+// Preenche algoritmosAtivos com as variantes registradas que participam desta execução
+void selecionarAlgoritmos(int incluirMultiPivo) {
+    quantidadeAlgoritmosAtivos = 0;
+    for (int id = 0; id < QUANTIDADE_REGISTRADOS; id++) {
+        if (!registroAlgoritmos[id].multiPivo || incluirMultiPivo) {
+            algoritmosAtivos[quantidadeAlgoritmosAtivos++] = id;
+        }
     }
 }
 
 // Função auxiliar para executar e imprimir resultados
-void executarOrdenacao(void (*algoritmo)(int*, int, int), int arr[], int n, char *sigla, FILE *outputArq, EstatisticasAlgoritmo estatisticas[], int posicao) {
+void executarOrdenacao(int idAlgoritmo, int arr[], int n, EstatisticasAlgoritmo estatisticas[], int posicao) {
+    EstatisticasAlgoritmo *resultado = &estatisticas[posicao];
     contagemChamadas = 0;  // Reinicia os contadores
     contagemTrocas = 0;
+    contagemComparacoes = 0;
+
+    if (configuracao.contadoresHardware) iniciarContadoresHardware();
+    long long inicio = obterTempoNanossegundos();
+    long long ciclosInicio = obterCiclos();
 
     // Executa o algoritmo de ordenação
-    algoritmo(arr, 0, n - 1);
+    registroAlgoritmos[idAlgoritmo].ordenar(arr, 0, n - 1);
+
+    resultado->ciclos = obterCiclos() - ciclosInicio;
+    resultado->tempoNanossegundos = obterTempoNanossegundos() - inicio;
+    pararContadoresHardware(resultado->contadoresHardware);  // Ficam -1 sem a opção -perf
 
     // Salva o resultado no arquivo de saída
-    estatisticas[posicao].operacoesTotais = contagemChamadas + contagemTrocas;
-    strcpy(estatisticas[posicao].siglaAlgoritmo, sigla);
+    resultado->operacoesTotais = contagemChamadas + contagemTrocas;
+    resultado->chamadas = contagemChamadas;
+    resultado->comparacoes = contagemComparacoes;
+    resultado->idAlgoritmo = idAlgoritmo;
+    resultado->prioridade = registroAlgoritmos[idAlgoritmo].prioridade;
+}
+
+
+// Thread trabalhadora: retira tarefas do lote até acabarem, cada uma com sua própria cópia da lista
+void *trabalhadorOrdenacao(void *arg) {
+    LoteListas *lote = ((Trabalhador *)arg)->lote;
+    BufferCrescente *copia = ((Trabalhador *)arg)->copia;
+    int totalTarefas = lote->quantidade * quantidadeAlgoritmosAtivos;
+
+    while (1) {
+        pthread_mutex_lock(&lote->trava);
+        int tarefa = lote->proximaTarefa++;
+        pthread_mutex_unlock(&lote->trava);
+        if (tarefa >= totalTarefas) break;
+
+        Lista *lista = &lote->listas[tarefa / quantidadeAlgoritmosAtivos];
+        int posicao = tarefa % quantidadeAlgoritmosAtivos;
+
+        if (!garantirCapacidade(copia, lista->tamanho)) {
+            lista->erroAlocacao = 1;
+            continue;
+        }
+        memcpy(copia->dados, lista->arrayOriginal.dados, lista->tamanho * sizeof(int));
+        executarOrdenacao(algoritmosAtivos[posicao], copia->dados, lista->tamanho, lista->estatisticas, posicao);
+    }
+    fecharContadoresHardware();
+    return NULL;
+}
+
+// Escreve a entrada de uma variante com todas as métricas medidas (opção -metricas)
+// Exemplo: HP(2800;cmp=5120;ns=10431;ciclos=28113) e, com -perf, ;instr=...;desvios=...;cache=...
+void imprimirMetricas(EscritorRapido *outputArq, EstatisticasAlgoritmo *estatisticas) {
+    escreverTexto(outputArq, registroAlgoritmos[estatisticas->idAlgoritmo].sigla);
+    escreverCaractere(outputArq, '(');
+    escreverInteiro(outputArq, estatisticas->operacoesTotais);
+    escreverTexto(outputArq, ";cmp=");
+    escreverInteiro(outputArq, estatisticas->comparacoes);
+    escreverTexto(outputArq, ";ns=");
+    escreverInteiro(outputArq, estatisticas->tempoNanossegundos);
+    escreverTexto(outputArq, ";ciclos=");
+    escreverInteiro(outputArq, estatisticas->ciclos);
+    if (configuracao.contadoresHardware) {
+        const char *nomes[QUANTIDADE_CONTADORES_HARDWARE] = {"instr", "desvios", "cache"};
+        for (int c = 0; c < QUANTIDADE_CONTADORES_HARDWARE; c++) {
+            escreverCaractere(outputArq, ';');
+            escreverTexto(outputArq, nomes[c]);
+            if (estatisticas->contadoresHardware[c] >= 0) {
+                escreverCaractere(outputArq, '=');
+                escreverInteiro(outputArq, estatisticas->contadoresHardware[c]);
+            } else {
+                escreverTexto(outputArq, "=n/d");
+            }
+        }
+    }
+    escreverCaractere(outputArq, ')');
+}
+
+// Ordena todas as listas do lote em paralelo e escreve os resultados na ordem da entrada
+int ordenarLote(LoteListas *lote, int indiceInicial, EscritorRapido *outputArq) {
+    int totalTarefas = lote->quantidade * quantidadeAlgoritmosAtivos;
+    int qtdThreads = totalTarefas < LIMITE_THREADS ? totalTarefas : LIMITE_THREADS;
+#ifdef _SC_NPROCESSORS_ONLN
+    // Mais threads que núcleos fariam as variantes disputarem a CPU durante a medição de tempo
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nucleos > 0 && qtdThreads > nucleos) qtdThreads = (int)nucleos;
+#endif
+    pthread_t threads[LIMITE_THREADS];
+    Trabalhador trabalhadores[LIMITE_THREADS];
+
+    lote->proximaTarefa = 0;
+    for (int t = 0; t < qtdThreads; t++) {
+        trabalhadores[t].lote = lote;
+        trabalhadores[t].copia = &lote->copias[t];
+        pthread_create(&threads[t], NULL, trabalhadorOrdenacao, &trabalhadores[t]);
+    }
+    for (int t = 0; t < qtdThreads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    for (int l = 0; l < lote->quantidade; l++) {
+        Lista *lista = &lote->listas[l];
+        if (lista->erroAlocacao) {
+            printf("Erro ao alocar memória para o buffer temporário\n");
+            return 0;
+        }
+
+        escreverInteiro(outputArq, indiceInicial + l);
+        escreverTexto(outputArq, ":N(");
+        escreverInteiro(outputArq, lista->tamanho);
+        escreverTexto(outputArq, "),");
+
+        for (int a = 0; a < quantidadeAlgoritmosAtivos; a++) {
+            lote->tempoTotal[a] += lista->estatisticas[a].tempoNanossegundos;
+            lote->chamadasTotal[a] += lista->estatisticas[a].chamadas;
+            lote->operacoesTotal[a] += lista->estatisticas[a].operacoesTotais;
+        }
+
+        /*
+         critérios de ordenação são:
+         1 - Número total de operações (trocas + chamadas): Ordenar em ordem crescente (menos operações vem primeiro).
+         2 - Desempate pela sigla: Se o número de operações for igual, usa-se a prioridade do registro:
+         LP > LM > LA > HP > HM > HA > DP > TP (mais à esquerda tem mais prioridade).
+        */
+        // Ordena o array de acordo com o número de trocas
+        ordenarEstatisticas(lista->estatisticas, quantidadeAlgoritmosAtivos, configuracao.ordenarPorTempo);
+
+        // Imprime o array ordenado
+        for (int i = 0; i < quantidadeAlgoritmosAtivos; i++) {
+            if (configuracao.incluirMetricas) {
+                imprimirMetricas(outputArq, &lista->estatisticas[i]);
+            } else {
+                escreverTexto(outputArq, registroAlgoritmos[lista->estatisticas[i].idAlgoritmo].sigla);
+                escreverCaractere(outputArq, '(');
+                escreverInteiro(outputArq, lista->estatisticas[i].operacoesTotais);
+                escreverCaractere(outputArq, ')');
+            }
+            if (i < quantidadeAlgoritmosAtivos - 1) {
+                escreverCaractere(outputArq, ',');
+            }
+        }
+
+        escreverCaractere(outputArq, '\n');
+    }
+    return 1;
+}
+
+// Libera todos os buffers do lote (chamada apenas no fim do processamento)
+void liberarLote(LoteListas *lote) {
+    for (int l = 0; l < LISTAS_POR_LOTE; l++) {
+        liberarBuffer(&lote->listas[l].arrayOriginal);
+    }
+    for (int t = 0; t < LIMITE_THREADS; t++) {
+        liberarBuffer(&lote->copias[t]);
+    }
+    lote->quantidade = 0;
 }
 
 // Processa os documentos
 void processarDocumentos(char *arqInput, char *arqOutput) {
-    FILE *inputArq = fopen(arqInput, "r");
-    FILE *outputArq = fopen(arqOutput, "w");
+    LeitorRapido inputArq;
+    int entradaAberta = abrirLeitor(&inputArq, arqInput);
+    EscritorRapido saida;
+    int saidaAberta = abrirEscritor(&saida, arqOutput);
+    EscritorRapido *outputArq = &saida;
 
-    if (!inputArq || !outputArq) {
+    if (!entradaAberta || !saidaAberta) {
         printf("Erro ao abrir os arquivos\n");
-        fclose(inputArq);
-        fclose(outputArq);
+        if (entradaAberta) fecharLeitor(&inputArq);
+        if (saidaAberta) fecharEscritor(outputArq);
         return;
     }
 
     int qtdListas, tamanhoLista;
-    EstatisticasAlgoritmo estatisticas[6] = {0};
 
-    if (fscanf(inputArq, "%d", &qtdListas) != 1) {
+    if (lerInteiro(&inputArq, &qtdListas) != 1) {
         printf("Erro ao ler a linha\n");
-        fclose(inputArq);
-        fclose(outputArq);
+        fecharLeitor(&inputArq);
+        fecharEscritor(outputArq);
         return;
     }
 
-    for (int i = 0; i < qtdListas; i++) {
-        if (fscanf(inputArq, "%d", &tamanhoLista) != 1) {
+    Lista listas[LISTAS_POR_LOTE] = {0};
+    LoteListas lote = {listas, 0, 0, PTHREAD_MUTEX_INITIALIZER, {0}, {0}, {0}, {{0}}};
+    int indiceInicial = 0;
+    int erroLeitura = 0;
+
+    for (int i = 0; i < qtdListas && !erroLeitura; i++) {
+        if (lerInteiro(&inputArq, &tamanhoLista) != 1) {
             printf("Erro ao ler a linha\n");
-            fclose(inputArq);
-            fclose(outputArq);
-            return;
+            erroLeitura = 1;
+            break;
         }
 
-        // Aloca o array original
-        int *arrayOriginal = malloc(tamanhoLista * sizeof(int));
-        if (!arrayOriginal) {
+        // Reaproveita o buffer desta posição do lote, crescendo apenas se necessário
+        Lista *lista = &listas[lote.quantidade];
+        if (!garantirCapacidade(&lista->arrayOriginal, tamanhoLista)) {
             printf("Erro ao alocar memória\n");
-            fclose(inputArq);
-            fclose(outputArq);
-            return;
+            erroLeitura = 1;
+            break;
         }
 
         // Lê os elementos para o array original
+        int *arrayOriginal = lista->arrayOriginal.dados;
         for (int j = 0; j < tamanhoLista; j++) {
-            if (fscanf(inputArq, "%d", &arrayOriginal[j]) != 1) {
+            if (lerInteiro(&inputArq, &arrayOriginal[j]) != 1) {
                 printf("Erro ao ler a linha\n");
-                free(arrayOriginal);
-                fclose(inputArq);
-                fclose(outputArq);
-                return;
+                erroLeitura = 1;
+                break;
             }
         }
-
-        // Aloca um buffer temporário
-        int *tempArray = malloc(tamanhoLista * sizeof(int));
-        if (!tempArray) {
-            printf("Erro ao alocar memória para o buffer temporário\n");
-            free(arrayOriginal);
-            fclose(inputArq);
-            fclose(outputArq);
-            return;
+        if (erroLeitura) break;
+
+        lista->tamanho = tamanhoLista;
+        lista->erroAlocacao = 0;
+        lote.quantidade++;
+
+        // Lote cheio: ordena em paralelo e escreve os resultados
+        if (lote.quantidade == LISTAS_POR_LOTE) {
+            int sucesso = ordenarLote(&lote, indiceInicial, outputArq);
+            indiceInicial += lote.quantidade;
+            lote.quantidade = 0;
+            if (!sucesso) erroLeitura = 1;
         }
+    }
 
-        // Executa os algoritmos de ordenação
-        fprintf(outputArq, "%d:N(%d),", i, tamanhoLista);
-        // O memcpy é usado para copiar o array original para o array temporário
-        memcpy(tempArray, arrayOriginal, tamanhoLista * sizeof(int));
-        executarOrdenacao(quickSortLomuto, tempArray, tamanhoLista, "LP", outputArq, estatisticas, 0);
-
-        memcpy(tempArray, arrayOriginal, tamanhoLista * sizeof(int));
-        executarOrdenacao(quickSortMedianaDeTres, tempArray, tamanhoLista, "LM", outputArq, estatisticas, 1);
-
-        memcpy(tempArray, arrayOriginal, tamanhoLista * sizeof(int));
-        executarOrdenacao(quickSortLomutoAleatorio, tempArray, tamanhoLista, "LA", outputArq, estatisticas, 2);
-
-        memcpy(tempArray, arrayOriginal, tamanhoLista * sizeof(int));
-        executarOrdenacao(quickSortHoare, tempArray, tamanhoLista, "HP", outputArq, estatisticas, 3);
-
-        memcpy(tempArray, arrayOriginal, tamanhoLista * sizeof(int));
-        executarOrdenacao(quickSortHoareMediana, tempArray, tamanhoLista, "HM", outputArq, estatisticas, 4);
-
-        memcpy(tempArray, arrayOriginal, tamanhoLista * sizeof(int));
-        executarOrdenacao(quickSortHoareAleatorio, tempArray, tamanhoLista, "HA", outputArq, estatisticas, 5);
-
-        /*
-         critérios de ordenação são:
-         1 - Número total de operações (trocas + chamadas): Ordenar em ordem crescente (menos operações vem primeiro).
-         2 - Desempate pela sigla: Se o número de operações for igual, usa-se a seguinte ordem de prioridade:
-         LP > LM > LA > HP > HM > HA (mais à esquerda tem mais prioridade).
-        */
-        // Ordena o array de acordo com o número de trocas
-        ordenarEstatisticas(estatisticas, 6);
-
-        // Imprime o array ordenado
-        for (int i = 0; i < 6; i++) {
-            if (i == 5) {
-                fprintf(outputArq, "%s(%d)", estatisticas[i].siglaAlgoritmo, estatisticas[i].operacoesTotais);
-                break;
-            }
-            fprintf(outputArq, "%s(%d),", estatisticas[i].siglaAlgoritmo, estatisticas[i].operacoesTotais);
+    // As listas lidas antes de um erro continuam sendo escritas, como na versão sequencial
+    if (lote.quantidade > 0) {
+        ordenarLote(&lote, indiceInicial, outputArq);
+    }
+    liberarLote(&lote);
+
+    // Com as variantes de múltiplos pivôs ou a rede de ordenação, informa os totais de cada variante
+    // (comparar execuções com e sem -rede mostra quanto caem as chamadas e o tempo)
+    if (configuracao.incluirMultiPivo || limiteRedeOrdenacao > 0) {
+        printf("Totais por variante:\n");
+        for (int a = 0; a < quantidadeAlgoritmosAtivos; a++) {
+            printf("%s: %lld chamadas, %lld operacoes, %.3f ms\n", registroAlgoritmos[algoritmosAtivos[a]].sigla,
+                   lote.chamadasTotal[a], lote.operacoesTotal[a], lote.tempoTotal[a] / 1e6);
         }
-
-        fprintf(outputArq, "\n");
-
-        // Libera a memória alocada
-        free(arrayOriginal);
-        free(tempArray);
     }
 
-    fclose(inputArq);
-    fclose(outputArq);
+    pthread_mutex_destroy(&lote.trava);
+    fecharLeitor(&inputArq);
+    fecharEscritor(outputArq);
 }
 
 int main(int argc, char **argv) {
     if (argc < 3) {
-        printf("Uso: %s <arquivo de entrada> <arquivo de saída>\n", argv[0]);
+        printf("Uso: %s <arquivo de entrada> <arquivo de saída> [-multipivo] [-metricas] [-tempo] [-perf] [-rede N]\n", argv[0]);
         return 1;
     }
 
+    // -multipivo: inclui as variantes DP (dois pivôs) e TP (três pivôs) no relatório
+    // -metricas:  cada variante é escrita com comparações, tempo (ns) e ciclos além das operações
+    // -tempo:     classifica as variantes pelo tempo de parede medido em vez de chamadas + trocas
+    // -rede N:    intervalos com até N (<= 16) elementos são ordenados por rede de ordenação
+    // -perf:      adiciona instruções, desvios mal previstos e falhas de cache (Linux, implica -metricas)
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "-multipivo") == 0) {
+            configuracao.incluirMultiPivo = 1;
+        } else if (strcmp(argv[i], "-metricas") == 0) {
+            configuracao.incluirMetricas = 1;
+        } else if (strcmp(argv[i], "-tempo") == 0) {
+            configuracao.ordenarPorTempo = 1;
+        } else if (strcmp(argv[i], "-rede") == 0 && i + 1 < argc) {
+            limiteRedeOrdenacao = atoi(argv[++i]);
+            if (limiteRedeOrdenacao < 0) limiteRedeOrdenacao = 0;
+            if (limiteRedeOrdenacao > MAXIMO_REDE_ORDENACAO) limiteRedeOrdenacao = MAXIMO_REDE_ORDENACAO;
+        } else if (strcmp(argv[i], "-perf") == 0) {
+            configuracao.contadoresHardware = 1;
+            configuracao.incluirMetricas = 1;
+        }
+    }
+
+    selecionarAlgoritmos(configuracao.incluirMultiPivo);
     processarDocumentos(argv[1], argv[2]);
 
     return 0;
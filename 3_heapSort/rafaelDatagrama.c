@@ -3,6 +3,10 @@
 #include <stdbool.h>
 #include <string.h>
 #include <stdint.h>
+#include "../comum/heapDario.h"
+
+#define ARIDADE_HEAP 4
+#define TAMANHO_TOKEN 1612  // Maior token de conteúdo lido por fscanf("%s"), com o '\0'
 
 typedef struct Pacote {
     int numero_pacote;
@@ -10,16 +14,36 @@ typedef struct Pacote {
     char **conteudo;
 } Pacote;
 
+#define MENOR_PACOTE(a, b) ((a).numero_pacote < (b).numero_pacote)
+DEFINIR_HEAP_DARIO(HeapPacotes, Pacote, ARIDADE_HEAP, MENOR_PACOTE)
+
+// Modo incremental (-incremental): os tokens de cada bloco ficam numa arena própria,
+// já separados por vírgula, e a fila guarda só a posição do pacote na arena.
+typedef struct Arena {
+    char* dados;
+    size_t usado;
+    size_t capacidade;
+    int pendentes;  // Pacotes do bloco que ainda não foram escritos
+} Arena;
+
+typedef struct Entrada {
+    int numero_pacote;
+    int bloco;            // Arena onde está o conteúdo
+    uint32_t inicio;      // Posição do conteúdo na arena
+    uint32_t comprimento; // Bytes do conteúdo ("tok,tok,...", sem vírgula final)
+} Entrada;
+
+#define MENOR_ENTRADA(a, b) ((a).numero_pacote < (b).numero_pacote)
+DEFINIR_HEAP_DARIO(FilaEntradas, Entrada, ARIDADE_HEAP, MENOR_ENTRADA)
+
 void trocar_pacote(Pacote* pacotes, uint32_t a, uint32_t b);
-uint32_t esquerdo(uint32_t i);
-uint32_t direito(uint32_t i);
-void construir_min_heap(Pacote* pacotes, uint32_t n);
-void heapify_min(Pacote* pacotes, uint32_t T, uint32_t i);
 void heapsort(Pacote* pacotes, uint32_t n);
+bool garantir_espaco(Arena* arena, size_t extra);
+int reordenar_incremental(FILE* input, FILE* output, int total_pacotes, int quantidade_ordenar);
 
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida>\n", argv[0]);
+    if (argc != 3 && !(argc == 4 && strcmp(argv[3], "-incremental") == 0)) {
+        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida> [-incremental]\n", argv[0]);
         return 1;
     }
 
@@ -39,6 +63,13 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    if (argc == 4) {
+        int status = reordenar_incremental(input, output, total_pacotes, quantidade_ordenar);
+        fclose(input);
+        fclose(output);
+        return status;
+    }
+
     Pacote *pacotes = malloc((total_pacotes + quantidade_ordenar) * sizeof(Pacote));
     if (!pacotes) {
         perror("Erro ao alocar memória para pacotes");
@@ -138,7 +169,7 @@ int main(int argc, char* argv[]) {
             fprintf(output, "|");
             pacote_esperado++;
             trocar_pacote(pacotes, 0, --lidos);
-            heapify_min(pacotes, lidos, 0);
+            descerHeapPacotes(pacotes, lidos, 0);
         }
     }
 
@@ -163,42 +194,116 @@ void trocar_pacote(Pacote* pacotes, uint32_t a, uint32_t b) {
     pacotes[b] = temp;
 }
 
-uint32_t esquerdo(uint32_t i) {
-    return 2 * i + 1;
-}
+void heapsort(Pacote* pacotes, uint32_t n) {
+    construirHeapPacotes(pacotes, n);
 
-uint32_t direito(uint32_t i) {
-    return 2 * i + 2;
+    for (uint32_t i = n - 1; i > 0; i--) {
+        trocar_pacote(pacotes, 0, i); 
+        descerHeapPacotes(pacotes, i, 0);
+    }
 }
 
-void construir_min_heap(Pacote* pacotes, uint32_t n) {
-    for (int32_t i = n / 2 - 1; i >= 0; i--) {
-        heapify_min(pacotes, n, i);
+bool garantir_espaco(Arena* arena, size_t extra) {
+    if (arena->usado + extra <= arena->capacidade) {
+        return true;
+    }
+    size_t nova_capacidade = arena->capacidade ? arena->capacidade : 4096;
+    while (nova_capacidade < arena->usado + extra) {
+        nova_capacidade *= 2;
     }
+    char* dados = realloc(arena->dados, nova_capacidade);
+    if (!dados) {
+        return false;
+    }
+    arena->dados = dados;
+    arena->capacidade = nova_capacidade;
+    return true;
 }
 
-void heapify_min(Pacote* pacotes, uint32_t T, uint32_t i) {
-    uint32_t P = i, E = esquerdo(i), D = direito(i);
-
-    if (E < T && pacotes[E].numero_pacote < pacotes[P].numero_pacote) {
-        P = E;
+// Insere cada pacote na fila assim que é lido e, ao fim de cada bloco, escreve os que
+// estão em sequência. A arena de um bloco é liberada quando o último pacote dele é escrito.
+int reordenar_incremental(FILE* input, FILE* output, int total_pacotes, int quantidade_ordenar) {
+    int quantidade_blocos = total_pacotes > 0 ? (total_pacotes + quantidade_ordenar - 1) / quantidade_ordenar : 0;
+    Arena* arenas = calloc(quantidade_blocos > 0 ? quantidade_blocos : 1, sizeof(Arena));
+    FilaEntradas fila;
+    if (!arenas || !iniciarFilaEntradas(&fila, quantidade_ordenar)) {
+        perror("Erro ao alocar memória para pacotes");
+        free(arenas);
+        return 1;
     }
 
-    if (D < T && pacotes[D].numero_pacote < pacotes[P].numero_pacote) {
-        P = D;
-    }
+    int pacote_esperado = 0;
+    int status = 0;
+    for (int bloco = 0; bloco < quantidade_blocos && status == 0; bloco++) {
+        int inicio = bloco * quantidade_ordenar;
+        int fim = inicio + quantidade_ordenar;
+        if (fim > total_pacotes) {
+            fim = total_pacotes;
+        }
 
-    if (P != i) {
-        trocar_pacote(pacotes, P, i);
-        heapify_min(pacotes, T, P);
-    }
-}
+        Arena* arena = &arenas[bloco];
+        for (int i = inicio; i < fim && status == 0; i++) {
+            Entrada entrada;
+            int tamanho;
+            if (fscanf(input, "%d %d", &entrada.numero_pacote, &tamanho) != 2) {
+                fprintf(stderr, "Erro ao ler numero_pacote e tamanho do pacote %d\n", i);
+                status = 1;
+                break;
+            }
+            entrada.bloco = bloco;
+            entrada.inicio = (uint32_t)arena->usado;
 
-void heapsort(Pacote* pacotes, uint32_t n) {
-    construir_min_heap(pacotes, n);
+            for (int j = 0; j < tamanho; j++) {
+                if (!garantir_espaco(arena, TAMANHO_TOKEN + 1)) {
+                    perror("Erro ao alocar memória para conteudo");
+                    status = 1;
+                    break;
+                }
+                char* token = arena->dados + arena->usado;
+                if (fscanf(input, "%1611s", token) != 1) {
+                    fprintf(stderr, "Erro ao ler conteudo[j] do pacote %d\n", i);
+                    status = 1;
+                    break;
+                }
+                arena->usado += strlen(token);
+                arena->dados[arena->usado++] = ',';
+            }
+            if (status) {
+                break;
+            }
 
-    for (uint32_t i = n - 1; i > 0; i--) {
-        trocar_pacote(pacotes, 0, i); 
-        heapify_min(pacotes, i, 0);    
+            entrada.comprimento = (uint32_t)(arena->usado - entrada.inicio);
+            if (tamanho > 0) {
+                entrada.comprimento--;  // A vírgula depois do último token fica fora
+            }
+            arena->pendentes++;
+            if (!inserirFilaEntradas(&fila, entrada)) {
+                perror("Erro ao alocar memória para pacotes");
+                status = 1;
+            }
+        }
+        if (status) {
+            break;
+        }
+
+        while (!vazioFilaEntradas(&fila) && fila.nos[0].numero_pacote == pacote_esperado) {
+            Entrada entrada = removerMinimoFilaEntradas(&fila);
+            Arena* origem = &arenas[entrada.bloco];
+            fwrite(origem->dados + entrada.inicio, 1, entrada.comprimento, output);
+            fputc('|', output);
+            pacote_esperado++;
+            if (--origem->pendentes == 0) {
+                free(origem->dados);
+                origem->dados = NULL;
+                origem->usado = origem->capacidade = 0;
+            }
+        }
     }
-}
\ No newline at end of file
+
+    for (int b = 0; b < quantidade_blocos; b++) {
+        free(arenas[b].dados);
+    }
+    free(arenas);
+    liberarFilaEntradas(&fila);
+    return status;
+}
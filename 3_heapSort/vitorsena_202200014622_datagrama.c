@@ -1,98 +1,1054 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <pthread.h>
+#ifndef _WIN32
+#include <errno.h>
+#include <unistd.h>
+#include <sys/uio.h>  // writev
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#endif
+#include "../comum/leitorRapido.h"  // Mapeamento do arquivo de entrada
+#include "../comum/escritorRapido.h"  // Saída com buffer (um write por descarga)
+#include "../comum/janelaReordenacao.h"  // Motor alternativo ao heap (opção -janela)
+#include "../comum/heapDario.h"  // Heap d-ário iterativo compartilhado
+// Compilar - gcc -o vitorsena_202200014622_datagrama vitorsena_202200014622_datagrama.c -pthread
 
 // Definições e limites
-#define MAX_BYTES 1600
+#define MAXIMO_PARTES_SAIDA 1024  // Trechos reunidos em cada writev (limite IOV_MAX comum)
+#define ARIDADE_HEAP 4            // Quatro filhos de 8 bytes por nó: cada grupo de irmãos cabe em 32 bytes alinhados
+#define TEXTO_ORIGINAL 0x80000000u   // Bit do cabeçalho do registro: bytes guardados como o texto lido
+#define SLAB_MINIMO_COMPACTAR (1 << 20)  // Só compacta o slab a partir deste tamanho
+#define ESPERA_PADRAO_MS 200       // Modo ao vivo: tempo máximo de espera por uma lacuna
+#define LIMITE_PADRAO_JANELA 1024  // Modo ao vivo: maior distância à frente do próximo esperado
 
-// Estrutura para representar um pacote
+// Entrada do heap: apenas a prioridade e o slot onde estão os dados do pacote.
+// Os dados ficam no slab, então as trocas do heap movem 8 bytes.
 typedef struct Pacote {
     int numeroPrioridade;   // Número do pacote
-    char dados[MAX_BYTES];  // Dados do pacote (em formato hexadecimal)
+    int slot;               // Posição do registro do pacote no slab (ou índice em fatias, no caminho mapeado)
 } Pacote;
 
+#define MENOR_PACOTE(a, b) ((a).numeroPrioridade < (b).numeroPrioridade)
+DEFINIR_HEAP_DARIO(HeapPacotes, Pacote, ARIDADE_HEAP, MENOR_PACOTE)
+
 // Protótipos das funções
+int guardarDados(const char *texto, size_t tamanho);
+void escreverDados(EscritorRapido *saida, int slot);
+void compactarSlab();
+int lerLinha(FILE *arquivo, char **linha, size_t *capacidade, size_t *tamanho);
+void processarFluxos(char* nomeArquivoEntrada, char* nomeArquivoSaida, int quantidadeThreads);
+void processarAoVivo(char* origem, char* nomeArquivoSaida, int esperaMs, int limiteJanela);
 void inserirPacoteNoHeap(Pacote p);
 Pacote removerPacoteDoHeap();
 int estaHeapVazia();
-void heapificarParaCima(int indice);
-void heapificarParaBaixo(int indice);
-void trocarPacotes(Pacote* a, Pacote* b);
+void iniciarReordenacao(int capacidade);
+void inserirPacote(Pacote p);
+int retirarProximoPacote(int posicaoSequencia, Pacote *p);
+void liberarReordenacao();
 void processarArquivoEntrada(char* nomeArquivoEntrada, char* nomeArquivoSaida);
+int processarArquivoMapeado(char* nomeArquivoEntrada, char* nomeArquivoSaida);
 
 // Variáveis globais
-Pacote *heapDePacotes;
-int tamanhoHeap = 0;
-int capacidadeHeap;
+HeapPacotes heapDePacotes;
+
+/*
+   Slab com os dados dos pacotes. Cada registro é um cabeçalho de 4 bytes com o
+   tamanho seguido dos bytes já decodificados ("01 AB FF" vira 3 bytes). Linhas
+   fora do formato "XX XX ..." (hexadecimal maiúsculo separado por um espaço) são
+   guardadas como o texto lido, com o bit TEXTO_ORIGINAL no cabeçalho, para que
+   a saída continue idêntica. Registros de pacotes já escritos só são
+   reaproveitados quando o slab é compactado.
+*/
+unsigned char *slab;
+size_t usadoSlab = 0;
+size_t capacidadeSlab = 0;
+size_t bytesVivosSlab = 0;   // Bytes dos registros de pacotes ainda não escritos
+
+// Valor de cada dígito hexadecimal maiúsculo somado de 1 (0 indica que não é dígito)
+static const unsigned char digitoHex[256] = {
+    ['0'] = 1,  ['1'] = 2,  ['2'] = 3,  ['3'] = 4,  ['4'] = 5,
+    ['5'] = 6,  ['6'] = 7,  ['7'] = 8,  ['8'] = 9,  ['9'] = 10,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16
+};
+
+// Motor de reordenação: heap (padrão) ou janela circular (opção -janela)
+int usarJanela = 0;
+JanelaReordenacao janela;
+
+// Funções para manipulação do slab
+unsigned char *reservarSlab(size_t tamanho) {
+    if (usadoSlab + tamanho > capacidadeSlab) {
+        size_t novaCapacidade = capacidadeSlab ? capacidadeSlab : 4096;
+        while (novaCapacidade < usadoSlab + tamanho) {
+            novaCapacidade *= 2;
+        }
+        unsigned char *novo = novaCapacidade <= INT_MAX ? realloc(slab, novaCapacidade) : NULL;
+        if (!novo) {
+            fprintf(stderr, "Erro de alocação do slab\n");
+            exit(1);
+        }
+        slab = novo;
+        capacidadeSlab = novaCapacidade;
+    }
+    return slab + usadoSlab;
+}
+
+// Decodifica a linha do pacote para o slab e retorna a posição do registro
+int guardarDados(const char *texto, size_t tamanho) {
+    int canonico = tamanho % 3 == 2;
+    for (size_t k = 0; k < tamanho && canonico; k += 3) {
+        canonico = digitoHex[(unsigned char)texto[k]] && digitoHex[(unsigned char)texto[k + 1]] &&
+                   (k + 2 == tamanho || texto[k + 2] == ' ');
+    }
+
+    uint32_t quantidade = canonico ? (uint32_t)((tamanho + 1) / 3) : (uint32_t)tamanho;
+    unsigned char *registro = reservarSlab(sizeof(uint32_t) + quantidade);
+    uint32_t cabecalho = canonico ? quantidade : (quantidade | TEXTO_ORIGINAL);
+    memcpy(registro, &cabecalho, sizeof(cabecalho));
+    unsigned char *bytes = registro + sizeof(cabecalho);
+    if (canonico) {
+        for (uint32_t b = 0; b < quantidade; b++) {
+            bytes[b] = (unsigned char)(((digitoHex[(unsigned char)texto[3 * b]] - 1) << 4) |
+                                       (digitoHex[(unsigned char)texto[3 * b + 1]] - 1));
+        }
+    } else {
+        memcpy(bytes, texto, tamanho);
+    }
+
+    int slot = (int)usadoSlab;
+    usadoSlab += sizeof(cabecalho) + quantidade;
+    bytesVivosSlab += sizeof(cabecalho) + quantidade;
+    return slot;
+}
+
+static inline uint32_t tamanhoRegistro(int slot) {
+    uint32_t cabecalho;
+    memcpy(&cabecalho, slab + slot, sizeof(cabecalho));
+    return cabecalho;
+}
+
+// Escreve "|dados" recodificando os bytes como hexadecimal separado por vírgulas
+void escreverDados(EscritorRapido *saida, int slot) {
+    uint32_t cabecalho = tamanhoRegistro(slot);
+    uint32_t quantidade = cabecalho & ~TEXTO_ORIGINAL;
+    const unsigned char *bytes = slab + slot + sizeof(cabecalho);
+
+    escreverCaractere(saida, '|');
+    if (cabecalho & TEXTO_ORIGINAL) {
+        escreverTrocando(saida, (const char *)bytes, quantidade, ' ', ',');
+    } else {
+        escreverHexadecimal(saida, bytes, quantidade, ',');
+    }
+    bytesVivosSlab -= sizeof(cabecalho) + quantidade;
+}
+
+// Copia o registro de um pacote pendente para o novo slab e atualiza o seu slot
+static inline void moverRegistro(unsigned char *novo, size_t *usado, int *slot) {
+    size_t tamanho = sizeof(uint32_t) + (tamanhoRegistro(*slot) & ~TEXTO_ORIGINAL);
+    memcpy(novo + *usado, slab + *slot, tamanho);
+    *slot = (int)*usado;
+    *usado += tamanho;
+}
+
+// Descarta os registros de pacotes já escritos, mantendo só os que estão no heap ou na janela
+void compactarSlab() {
+    unsigned char *novo = malloc(capacidadeSlab);
+    if (!novo) return;  // Sem memória para compactar: continua crescendo
+    size_t usado = 0;
+    if (usarJanela) {
+        for (int s = 0; s < janela.capacidade; s++) {
+            if (bitJanelaLigado(janela.presentes, s)) moverRegistro(novo, &usado, &janela.valores[s]);
+        }
+    } else {
+        for (int i = 0; i < heapDePacotes.tamanho; i++) {
+            moverRegistro(novo, &usado, &heapDePacotes.nos[i].slot);
+        }
+    }
+    free(slab);
+    slab = novo;
+    usadoSlab = usado;
+    bytesVivosSlab = usado;
+}
 
 // Funções para manipulação do heap
 void inserirPacoteNoHeap(Pacote p) {
-    if (tamanhoHeap >= capacidadeHeap) {
-        capacidadeHeap *= 2;
-        heapDePacotes = realloc(heapDePacotes, capacidadeHeap * sizeof(Pacote));
+    if (!inserirHeapPacotes(&heapDePacotes, p)) {
+        fprintf(stderr, "Erro de alocação do heap\n");
+        exit(1);
     }
-    heapDePacotes[tamanhoHeap] = p;
-    heapificarParaCima(tamanhoHeap);
-    tamanhoHeap++;
 }
 
 Pacote removerPacoteDoHeap() {
-    if (tamanhoHeap == 0) {
+    if (estaHeapVazia()) {
         fprintf(stderr, "Heap está vazio\n");
         exit(1);
     }
-    Pacote pacoteRaiz = heapDePacotes[0];
-    heapDePacotes[0] = heapDePacotes[--tamanhoHeap];
-    heapificarParaBaixo(0);
-    return pacoteRaiz;
+    return removerMinimoHeapPacotes(&heapDePacotes);
 }
 
 int estaHeapVazia() {
-    return tamanhoHeap == 0;
+    return vazioHeapPacotes(&heapDePacotes);
+}
+
+// Funções que escolhem entre o heap e a janela de reordenação
+void iniciarReordenacao(int capacidade) {
+    if (!iniciarHeapPacotes(&heapDePacotes, capacidade) || (usarJanela && !iniciarJanela(&janela, capacidade, 0))) {
+        fprintf(stderr, "Erro de alocação\n");
+        exit(1);
+    }
+}
+
+void inserirPacote(Pacote p) {
+    if (!usarJanela) {
+        inserirPacoteNoHeap(p);
+    } else if (!inserirNaJanela(&janela, p.numeroPrioridade, p.slot)) {
+        fprintf(stderr, "Erro de alocação da janela de reordenação\n");
+        exit(1);
+    }
+}
+
+// Retira o pacote 'posicaoSequencia' se ele já tiver chegado; retorna 1 em caso de sucesso
+int retirarProximoPacote(int posicaoSequencia, Pacote *p) {
+    if (usarJanela) {
+        p->numeroPrioridade = posicaoSequencia;
+        return retirarDaJanela(&janela, &p->slot);
+    }
+    if (estaHeapVazia() || heapDePacotes.nos[0].numeroPrioridade != posicaoSequencia) {
+        return 0;
+    }
+    *p = removerPacoteDoHeap();
+    return 1;
+}
+
+void liberarReordenacao() {
+    liberarHeapPacotes(&heapDePacotes);
+    if (usarJanela) liberarJanela(&janela);
+}
+
+#ifndef _WIN32
+// Trecho do arquivo mapeado com os dados de um pacote (bytes hexadecimais separados por espaço)
+typedef struct Fatia {
+    size_t inicio;   // Posição do primeiro byte no arquivo mapeado
+    size_t tamanho;  // Bytes até o fim da linha
+} Fatia;
+
+// Saída por escrita reunida: acumula ponteiros para os trechos e grava todos com um writev
+typedef struct SaidaReunida {
+    int descritor;
+    struct iovec partes[MAXIMO_PARTES_SAIDA];
+    int quantidade;
+    int erro;
+} SaidaReunida;
+
+void descarregarSaida(SaidaReunida *saida) {
+    struct iovec *parte = saida->partes;
+    int restantes = saida->quantidade;
+    while (restantes > 0 && !saida->erro) {
+        ssize_t escritos = writev(saida->descritor, parte, restantes);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            saida->erro = 1;
+            break;
+        }
+        // Escrita parcial: pula os trechos completos e ajusta o primeiro pendente
+        while (restantes > 0 && (size_t)escritos >= parte->iov_len) {
+            escritos -= (ssize_t)parte->iov_len;
+            parte++;
+            restantes--;
+        }
+        if (restantes > 0) {
+            parte->iov_base = (char *)parte->iov_base + escritos;
+            parte->iov_len -= (size_t)escritos;
+        }
+    }
+    saida->quantidade = 0;
+}
+
+void adicionarSaida(SaidaReunida *saida, const char *dados, size_t tamanho) {
+    if (saida->quantidade == MAXIMO_PARTES_SAIDA) {
+        descarregarSaida(saida);
+    }
+    saida->partes[saida->quantidade].iov_base = (void *)dados;
+    saida->partes[saida->quantidade].iov_len = tamanho;
+    saida->quantidade++;
+}
+
+// Lê "numero tamanho dados" como o fscanf("%d %d %[^\n]") do caminho com stdio
+int lerPacoteMapeado(LeitorRapido *leitor, int *numeroPacote, Fatia *fatia) {
+    int tamanhoPacote;
+    if (!lerInteiro(leitor, numeroPacote) || !lerInteiro(leitor, &tamanhoPacote)) return 0;
+    if (pularEspacos(leitor) == EOF) return 0;
+
+    const char *inicio = leitor->dados + leitor->posicao;
+    const char *fimLinha = memchr(inicio, '\n', leitor->tamanho - leitor->posicao);
+    size_t tamanho = fimLinha ? (size_t)(fimLinha - inicio) : leitor->tamanho - leitor->posicao;
+    fatia->inicio = leitor->posicao;
+    fatia->tamanho = tamanho;
+    leitor->posicao += tamanho;
+    return 1;
+}
+
+/*
+   Caminho sem cópias: o arquivo é mapeado numa cópia privada e cada pacote é só
+   uma fatia (início, tamanho) dele. A troca de espaços por vírgulas é feita no
+   próprio mapeamento, no momento em que o pacote é enviado para a saída, e a
+   saída é montada com ponteiros para as fatias e gravada por writev.
+   Retorna 0 se o arquivo não puder ser mapeado (o chamador usa o caminho com stdio).
+*/
+int processarArquivoMapeado(char* nomeArquivoEntrada, char* nomeArquivoSaida) {
+    LeitorRapido leitor;
+    if (!abrirLeitorMapeadoGravavel(&leitor, nomeArquivoEntrada)) {
+        return 0;
+    }
+    char *mapa = (char *)leitor.dados;
+
+    int quantidadePacotes, quantidadePacotesBloco;
+    if (!lerInteiro(&leitor, &quantidadePacotes) || !lerInteiro(&leitor, &quantidadePacotesBloco)) {
+        fecharLeitor(&leitor);
+        return 0;  // O caminho com stdio reporta o erro
+    }
+
+    FILE* arquivoSaida = fopen(nomeArquivoSaida, "w");
+    if (!arquivoSaida) {
+        perror("Erro ao abrir arquivo");
+        exit(1);
+    }
+
+    int quantidadeBlocos = (quantidadePacotes + quantidadePacotesBloco - 1) / quantidadePacotesBloco;
+    Fatia *fatias = malloc(sizeof(Fatia) * ((size_t)quantidadeBlocos * quantidadePacotesBloco + 1));
+    iniciarReordenacao(quantidadePacotesBloco);
+    static SaidaReunida saida;
+    saida.descritor = fileno(arquivoSaida);
+    saida.quantidade = 0;
+    saida.erro = 0;
+    if (!fatias) {
+        fprintf(stderr, "Erro de alocação\n");
+        exit(1);
+    }
+
+    int posicaoSequencia = 0;
+    int quantidadeFatias = 0;
+    for (int i = 0; i < quantidadeBlocos; i++) {
+        for (int j = 0; j < quantidadePacotesBloco; j++) {
+            Pacote p;
+            if (!lerPacoteMapeado(&leitor, &p.numeroPrioridade, &fatias[quantidadeFatias])) {
+                break;
+            }
+            p.slot = quantidadeFatias++;
+            inserirPacote(p);
+        }
+
+        int primeiraImpressao = 1;
+        Pacote p;
+        while (retirarProximoPacote(posicaoSequencia, &p)) {
+            char *dados = mapa + fatias[p.slot].inicio;
+            for (size_t k = 0; k < fatias[p.slot].tamanho; k++) {
+                if (dados[k] == ' ') dados[k] = ',';
+            }
+            adicionarSaida(&saida, "|", 1);
+            adicionarSaida(&saida, dados, fatias[p.slot].tamanho);
+            primeiraImpressao = 0;
+            posicaoSequencia++;
+        }
+        if (!primeiraImpressao) {
+            adicionarSaida(&saida, "|\n", 2);
+        }
+    }
+    descarregarSaida(&saida);
+    if (saida.erro) {
+        perror("Erro ao escrever arquivo de saída");
+    }
+
+    fclose(arquivoSaida);
+    liberarReordenacao();
+    free(fatias);
+    fecharLeitor(&leitor);  // As fatias apontam para o mapeamento: só pode ser desfeito após a última escrita
+    return 1;
 }
+#endif
 
-void heapificarParaCima(int indice) {
-    while (indice > 0 && heapDePacotes[indice].numeroPrioridade < heapDePacotes[(indice - 1) / 2].numeroPrioridade) {
-        trocarPacotes(&heapDePacotes[indice], &heapDePacotes[(indice - 1) / 2]);
-        indice = (indice - 1) / 2;
+//----------------[ Vários fluxos (opção -fluxos N) ]----------------
+
+/*
+   Cada linha traz o identificador do fluxo antes do número do pacote:
+     fluxo numero tamanho dados
+   Cada fluxo tem a sua própria sequência (começando em 0) e o seu próprio heap.
+   A regra de blocos é a mesma do modo simples: ao fim de cada bloco de
+   quantidadePacotesBloco linhas, cada fluxo que recebeu pacotes escreve os que
+   já estão em sequência, numa linha "|dados|dados|".
+
+   A leitura é feita por uma thread; os pacotes são repartidos em fragmentos
+   pelo hash do fluxo e cada fragmento é reordenado por uma thread trabalhadora
+   com o seu próprio mapa de fluxos, sem travas. A saída traz, para cada fluxo
+   em ordem crescente de identificador, a linha "fluxo N" seguida das suas linhas.
+*/
+
+#define LIMITE_THREADS_FLUXOS 64
+
+// Pacote de um fluxo: o conteúdo é uma fatia do arquivo de entrada
+typedef struct PacoteFluxo {
+    int fluxo;
+    int numero;
+    int bloco;          // Bloco de entrada em que o pacote chegou
+    uint32_t tamanho;   // Bytes da fatia
+    size_t inicio;      // Posição da fatia no arquivo
+} PacoteFluxo;
+
+// Estado de reordenação de um fluxo
+typedef struct EstadoFluxo {
+    int fluxo;
+    int posicaoSequencia;
+    int ultimoBloco;    // Último bloco em que o fluxo recebeu pacotes
+    HeapPacotes heap;   // slot = índice do pacote no fragmento
+    char *saida;
+    size_t usadoSaida;
+    size_t capacidadeSaida;
+} EstadoFluxo;
+
+// Fragmento: pacotes e fluxos tratados por uma thread
+typedef struct Fragmento {
+    const char *dados;      // Arquivo de entrada inteiro
+    PacoteFluxo *pacotes;
+    int quantidadePacotes;
+    int capacidadePacotes;
+    EstadoFluxo *fluxos;
+    int quantidadeFluxos;
+    int capacidadeFluxos;
+    int *tabela;            // Mapa fluxo -> índice em fluxos (endereçamento aberto, -1 = vazio)
+    int capacidadeTabela;   // Potência de dois
+    int *tocados;           // Fluxos que receberam pacotes no bloco atual
+    int quantidadeTocados;
+} Fragmento;
+
+static inline unsigned int hashFluxo(int fluxo) {
+    return (unsigned int)fluxo * 2654435761u;
+}
+
+void *alocarOuSair(void *ponteiro) {
+    if (!ponteiro) {
+        fprintf(stderr, "Erro de alocação\n");
+        exit(1);
+    }
+    return ponteiro;
+}
+
+// Acrescenta os bytes à saída do fluxo, trocando espaços por vírgulas se pedido
+void acrescentarSaida(EstadoFluxo *estado, const char *dados, size_t tamanho, int trocarEspacos) {
+    if (estado->usadoSaida + tamanho > estado->capacidadeSaida) {
+        size_t novaCapacidade = estado->capacidadeSaida ? estado->capacidadeSaida : 256;
+        while (novaCapacidade < estado->usadoSaida + tamanho) {
+            novaCapacidade *= 2;
+        }
+        estado->saida = alocarOuSair(realloc(estado->saida, novaCapacidade));
+        estado->capacidadeSaida = novaCapacidade;
+    }
+    char *destino = estado->saida + estado->usadoSaida;
+    if (trocarEspacos) {
+        for (size_t k = 0; k < tamanho; k++) {
+            destino[k] = dados[k] == ' ' ? ',' : dados[k];
+        }
+    } else {
+        memcpy(destino, dados, tamanho);
     }
+    estado->usadoSaida += tamanho;
 }
 
-void heapificarParaBaixo(int indice) {
-    int menor = indice;
-    int filhoEsquerdo = 2 * indice + 1;
-    int filhoDireito = 2 * indice + 2;
+void dobrarTabela(Fragmento *fragmento) {
+    int novaCapacidade = fragmento->capacidadeTabela ? fragmento->capacidadeTabela * 2 : 64;
+    int *tabela = alocarOuSair(malloc(sizeof(int) * novaCapacidade));
+    for (int i = 0; i < novaCapacidade; i++) tabela[i] = -1;
+    for (int f = 0; f < fragmento->quantidadeFluxos; f++) {
+        unsigned int posicao = hashFluxo(fragmento->fluxos[f].fluxo) & (unsigned int)(novaCapacidade - 1);
+        while (tabela[posicao] != -1) posicao = (posicao + 1) & (unsigned int)(novaCapacidade - 1);
+        tabela[posicao] = f;
+    }
+    free(fragmento->tabela);
+    fragmento->tabela = tabela;
+    fragmento->capacidadeTabela = novaCapacidade;
+}
+
+// Retorna o índice do estado do fluxo, criando-o na primeira vez
+int buscarFluxo(Fragmento *fragmento, int fluxo) {
+    if (2 * (fragmento->quantidadeFluxos + 1) > fragmento->capacidadeTabela) {
+        dobrarTabela(fragmento);
+    }
+    unsigned int mascara = (unsigned int)(fragmento->capacidadeTabela - 1);
+    unsigned int posicao = hashFluxo(fluxo) & mascara;
+    while (fragmento->tabela[posicao] != -1) {
+        if (fragmento->fluxos[fragmento->tabela[posicao]].fluxo == fluxo) {
+            return fragmento->tabela[posicao];
+        }
+        posicao = (posicao + 1) & mascara;
+    }
 
-    if (filhoEsquerdo < tamanhoHeap && heapDePacotes[filhoEsquerdo].numeroPrioridade < heapDePacotes[menor].numeroPrioridade) {
-        menor = filhoEsquerdo;
+    if (fragmento->quantidadeFluxos == fragmento->capacidadeFluxos) {
+        fragmento->capacidadeFluxos = fragmento->capacidadeFluxos ? fragmento->capacidadeFluxos * 2 : 16;
+        fragmento->fluxos = alocarOuSair(realloc(fragmento->fluxos, sizeof(EstadoFluxo) * fragmento->capacidadeFluxos));
+        fragmento->tocados = alocarOuSair(realloc(fragmento->tocados, sizeof(int) * fragmento->capacidadeFluxos));
     }
-    if (filhoDireito < tamanhoHeap && heapDePacotes[filhoDireito].numeroPrioridade < heapDePacotes[menor].numeroPrioridade) {
-        menor = filhoDireito;
+    int indice = fragmento->quantidadeFluxos++;
+    EstadoFluxo *estado = &fragmento->fluxos[indice];
+    memset(estado, 0, sizeof(*estado));
+    estado->fluxo = fluxo;
+    estado->ultimoBloco = -1;
+    if (!iniciarHeapPacotes(&estado->heap, 16)) alocarOuSair(NULL);
+    fragmento->tabela[posicao] = indice;
+    return indice;
+}
+
+// Escreve os pacotes em sequência de cada fluxo que recebeu pacotes no bloco
+void descarregarTocados(Fragmento *fragmento) {
+    for (int t = 0; t < fragmento->quantidadeTocados; t++) {
+        EstadoFluxo *estado = &fragmento->fluxos[fragmento->tocados[t]];
+        int escreveu = 0;
+        while (!vazioHeapPacotes(&estado->heap) && estado->heap.nos[0].numeroPrioridade == estado->posicaoSequencia) {
+            const PacoteFluxo *pacote = &fragmento->pacotes[removerMinimoHeapPacotes(&estado->heap).slot];
+            acrescentarSaida(estado, "|", 1, 0);
+            acrescentarSaida(estado, fragmento->dados + pacote->inicio, pacote->tamanho, 1);
+            estado->posicaoSequencia++;
+            escreveu = 1;
+        }
+        if (escreveu) {
+            acrescentarSaida(estado, "|\n", 2, 0);
+        }
     }
-    if (menor != indice) {
-        trocarPacotes(&heapDePacotes[indice], &heapDePacotes[menor]);
-        heapificarParaBaixo(menor);
+    fragmento->quantidadeTocados = 0;
+}
+
+void *reordenarFragmento(void *argumento) {
+    Fragmento *fragmento = argumento;
+    int blocoAtual = -1;
+    for (int k = 0; k < fragmento->quantidadePacotes; k++) {
+        const PacoteFluxo *pacote = &fragmento->pacotes[k];
+        if (pacote->bloco != blocoAtual) {
+            descarregarTocados(fragmento);
+            blocoAtual = pacote->bloco;
+        }
+        int indice = buscarFluxo(fragmento, pacote->fluxo);
+        EstadoFluxo *estado = &fragmento->fluxos[indice];
+        if (estado->ultimoBloco != blocoAtual) {
+            estado->ultimoBloco = blocoAtual;
+            fragmento->tocados[fragmento->quantidadeTocados++] = indice;
+        }
+        Pacote p = {pacote->numero, k};
+        if (!inserirHeapPacotes(&estado->heap, p)) alocarOuSair(NULL);
     }
+    descarregarTocados(fragmento);
+    return NULL;
 }
 
-void trocarPacotes(Pacote* a, Pacote* b) {
-    Pacote temp = *a;
-    *a = *b;
-    *b = temp;
+int compararFluxos(const void *a, const void *b) {
+    const EstadoFluxo *x = *(EstadoFluxo *const *)a;
+    const EstadoFluxo *y = *(EstadoFluxo *const *)b;
+    return (x->fluxo > y->fluxo) - (x->fluxo < y->fluxo);
+}
+
+void processarFluxos(char* nomeArquivoEntrada, char* nomeArquivoSaida, int quantidadeThreads) {
+    LeitorRapido leitor;
+    if (!abrirLeitorCompleto(&leitor, nomeArquivoEntrada)) {
+        perror("Erro ao abrir arquivo");
+        exit(1);
+    }
+    int quantidadePacotes, quantidadePacotesBloco;
+    if (!lerInteiro(&leitor, &quantidadePacotes) || !lerInteiro(&leitor, &quantidadePacotesBloco) ||
+        quantidadePacotesBloco <= 0) {
+        fprintf(stderr, "Erro ao ler quantidade de pacotes e pacotes por bloco\n");
+        exit(1);
+    }
+
+    // Leitura: cada pacote vai para o fragmento do seu fluxo, na ordem de chegada
+    Fragmento fragmentos[LIMITE_THREADS_FLUXOS];
+    memset(fragmentos, 0, sizeof(fragmentos));
+    for (int i = 0; i < quantidadePacotes; i++) {
+        PacoteFluxo pacote;
+        int tamanhoPacote;
+        if (!lerInteiro(&leitor, &pacote.fluxo) || !lerInteiro(&leitor, &pacote.numero) ||
+            !lerInteiro(&leitor, &tamanhoPacote) || pularEspacos(&leitor) == EOF) {
+            break;
+        }
+        const char *inicio = leitor.dados + leitor.posicao;
+        const char *fimLinha = memchr(inicio, '\n', leitor.tamanho - leitor.posicao);
+        size_t tamanho = fimLinha ? (size_t)(fimLinha - inicio) : leitor.tamanho - leitor.posicao;
+        pacote.bloco = i / quantidadePacotesBloco;
+        pacote.inicio = leitor.posicao;
+        pacote.tamanho = (uint32_t)tamanho;
+        leitor.posicao += tamanho;
+
+        Fragmento *fragmento = &fragmentos[(hashFluxo(pacote.fluxo) >> 16) % (unsigned int)quantidadeThreads];
+        if (fragmento->quantidadePacotes == fragmento->capacidadePacotes) {
+            fragmento->capacidadePacotes = fragmento->capacidadePacotes ? fragmento->capacidadePacotes * 2 : 1024;
+            fragmento->pacotes = alocarOuSair(realloc(fragmento->pacotes, sizeof(PacoteFluxo) * fragmento->capacidadePacotes));
+        }
+        fragmento->pacotes[fragmento->quantidadePacotes++] = pacote;
+    }
+
+    pthread_t threads[LIMITE_THREADS_FLUXOS];
+    int criada[LIMITE_THREADS_FLUXOS];
+    for (int t = 0; t < quantidadeThreads; t++) {
+        fragmentos[t].dados = leitor.dados;
+        criada[t] = pthread_create(&threads[t], NULL, reordenarFragmento, &fragmentos[t]) == 0;
+        if (!criada[t]) {
+            reordenarFragmento(&fragmentos[t]);  // Sem thread disponível: processa nesta mesma
+        }
+    }
+    for (int t = 0; t < quantidadeThreads; t++) {
+        if (criada[t]) pthread_join(threads[t], NULL);
+    }
+
+    // Saída em ordem de fluxo, independente da divisão entre threads
+    int totalFluxos = 0;
+    for (int t = 0; t < quantidadeThreads; t++) totalFluxos += fragmentos[t].quantidadeFluxos;
+    EstadoFluxo **ordem = alocarOuSair(malloc(sizeof(EstadoFluxo *) * (totalFluxos > 0 ? totalFluxos : 1)));
+    int posicao = 0;
+    for (int t = 0; t < quantidadeThreads; t++) {
+        for (int f = 0; f < fragmentos[t].quantidadeFluxos; f++) ordem[posicao++] = &fragmentos[t].fluxos[f];
+    }
+    qsort(ordem, totalFluxos, sizeof(EstadoFluxo *), compararFluxos);
+
+    EscritorRapido saida;
+    if (!abrirEscritor(&saida, nomeArquivoSaida)) {
+        perror("Erro ao abrir arquivo");
+        exit(1);
+    }
+    for (int f = 0; f < totalFluxos; f++) {
+        escreverTexto(&saida, "fluxo ");
+        escreverInteiro(&saida, ordem[f]->fluxo);
+        escreverCaractere(&saida, '\n');
+        escreverBytes(&saida, ordem[f]->saida, ordem[f]->usadoSaida);
+    }
+    if (!fecharEscritor(&saida)) {
+        perror("Erro ao escrever arquivo de saída");
+    }
+
+    for (int t = 0; t < quantidadeThreads; t++) {
+        for (int f = 0; f < fragmentos[t].quantidadeFluxos; f++) {
+            liberarHeapPacotes(&fragmentos[t].fluxos[f].heap);
+            free(fragmentos[t].fluxos[f].saida);
+        }
+        free(fragmentos[t].pacotes);
+        free(fragmentos[t].fluxos);
+        free(fragmentos[t].tabela);
+        free(fragmentos[t].tocados);
+    }
+    free(ordem);
+    fecharLeitor(&leitor);
+}
+
+//----------------[ Ingestão ao vivo (opção -ao-vivo) ]----------------
+
+/*
+   Em vez do arquivo com cabeçalho, os pacotes chegam continuamente, um por
+   linha no formato "numero tamanho dados", de um socket UDP em 127.0.0.1
+   (origem "udp:PORTA", uma ou mais linhas por datagrama) ou de um FIFO
+   (qualquer outro caminho; um arquivo comum também serve). A linha "FIM", o
+   fim do FIFO ou SIGINT/SIGTERM encerram a leitura.
+
+   A reordenação usa a janela circular, sem a regra de blocos: a cada evento os
+   pacotes que ficaram em sequência são escritos numa linha "|dados|dados|" e a
+   saída é descarregada na hora. Uma lacuna na sequência espera no máximo
+   'espera' ms, contados a partir de quando ela passou a segurar pacotes; depois
+   disso os números que faltam são dados como perdidos. Um pacote 'limite' ou
+   mais números à frente do próximo esperado também força o descarte das
+   lacunas anteriores, o que limita a memória da janela.
+
+   Contadores: atrasado é um número que já foi entregue ou dado como perdido;
+   repetido é um número que ainda está guardado na janela. Ao final, os
+   contadores e dois histogramas (latência da chegada até a escrita e distância
+   à frente do próximo esperado na chegada) são impressos em stderr.
+*/
+
+#ifndef _WIN32
+#define TAMANHO_LEITURA_VIVO 65536   // Maior datagrama UDP; tamanho inicial do buffer do FIFO
+#define FAIXAS_HISTOGRAMA 32
+
+// Pacote guardado na janela; os registros são reaproveitados por uma lista livre
+typedef struct PacoteVivo {
+    char *dados;          // Já com vírgulas no lugar dos espaços
+    size_t tamanho;
+    size_t capacidade;    // O buffer é mantido quando o registro volta para a lista livre
+    long long chegada;    // Instante da chegada (us, relógio monotônico)
+    int proximoLivre;
+} PacoteVivo;
+
+// Histograma em faixas de potências de dois: a faixa k guarda valores em [2^(k-1), 2^k), a faixa 0 o valor 0
+typedef struct Histograma {
+    const char *titulo;
+    long long faixas[FAIXAS_HISTOGRAMA];
+} Histograma;
+
+typedef struct EstadoVivo {
+    EscritorRapido saida;
+    JanelaReordenacao janela;   // Handle = índice em registros
+    PacoteVivo *registros;
+    int quantidadeRegistros;
+    int capacidadeRegistros;
+    int primeiroLivre;          // -1: lista livre vazia
+    int limite;
+    long long esperaUs;
+    long long inicioLacuna;     // -1: nenhuma lacuna segurando pacotes
+    long long recebidos, entregues, atrasados, repetidos, perdidos, invalidos, lacunasPorTempo;
+    Histograma latencia;
+    Histograma distancia;
+} EstadoVivo;
+
+static volatile sig_atomic_t pararLeitura = 0;
+
+static void sinalParar(int sinal) {
+    (void)sinal;
+    pararLeitura = 1;
+}
+
+static long long agoraMicrossegundos(void) {
+    struct timespec instante;
+    clock_gettime(CLOCK_MONOTONIC, &instante);
+    return (long long)instante.tv_sec * 1000000LL + instante.tv_nsec / 1000;
+}
+
+void registrarHistograma(Histograma *histograma, long long valor) {
+    int faixa = 0;
+    while (valor > 0 && faixa < FAIXAS_HISTOGRAMA - 1) {
+        valor >>= 1;
+        faixa++;
+    }
+    histograma->faixas[faixa]++;
+}
+
+void imprimirHistograma(const Histograma *histograma) {
+    fprintf(stderr, "%s:\n", histograma->titulo);
+    for (int k = 0; k < FAIXAS_HISTOGRAMA; k++) {
+        if (histograma->faixas[k] == 0) continue;
+        if (k == 0) {
+            fprintf(stderr, "  %24s  %lld\n", "0", histograma->faixas[k]);
+        } else {
+            char faixa[32];
+            snprintf(faixa, sizeof(faixa), "[%lld, %lld)", 1LL << (k - 1), 1LL << k);
+            fprintf(stderr, "  %24s  %lld\n", faixa, histograma->faixas[k]);
+        }
+    }
+}
+
+int novoRegistroVivo(EstadoVivo *estado) {
+    if (estado->primeiroLivre >= 0) {
+        int indice = estado->primeiroLivre;
+        estado->primeiroLivre = estado->registros[indice].proximoLivre;
+        return indice;
+    }
+    if (estado->quantidadeRegistros == estado->capacidadeRegistros) {
+        estado->capacidadeRegistros = estado->capacidadeRegistros ? estado->capacidadeRegistros * 2 : 64;
+        estado->registros = alocarOuSair(realloc(estado->registros, sizeof(PacoteVivo) * estado->capacidadeRegistros));
+    }
+    int indice = estado->quantidadeRegistros++;
+    memset(&estado->registros[indice], 0, sizeof(PacoteVivo));
+    return indice;
+}
+
+// Escreve numa linha os pacotes que já estão em sequência e descarrega a saída
+void entregarEmSequencia(EstadoVivo *estado) {
+    int indice, escreveu = 0;
+    while (retirarDaJanela(&estado->janela, &indice)) {
+        PacoteVivo *pacote = &estado->registros[indice];
+        escreverCaractere(&estado->saida, '|');
+        escreverBytes(&estado->saida, pacote->dados, pacote->tamanho);
+        registrarHistograma(&estado->latencia, agoraMicrossegundos() - pacote->chegada);
+        pacote->proximoLivre = estado->primeiroLivre;
+        estado->primeiroLivre = indice;
+        estado->entregues++;
+        escreveu = 1;
+    }
+    if (escreveu) {
+        escreverBytes(&estado->saida, "|\n", 2);
+        descarregarEscritor(&estado->saida);
+    }
+}
+
+// Desiste da lacuna no começo da janela e entrega o que vem depois dela
+void desistirDaLacuna(EstadoVivo *estado) {
+    while (pularLacunaJanela(&estado->janela)) {
+        estado->perdidos++;
+    }
+    entregarEmSequencia(estado);
+}
+
+// Abre espaço para 'numero' caber no limite da janela, desistindo das lacunas mais antigas
+void avancarJanelaAte(EstadoVivo *estado, int numero) {
+    long long novaBase = (long long)numero - estado->limite + 1;
+    while (estado->janela.base < novaBase && !janelaVazia(&estado->janela)) {
+        desistirDaLacuna(estado);
+    }
+    if (estado->janela.base < novaBase) {
+        estado->perdidos += novaBase - estado->janela.base;
+        reposicionarJanela(&estado->janela, (int)novaBase);
+    }
+}
+
+static int lerInteiroTexto(const char **cursor, const char *fim, long long *valor) {
+    const char *c = *cursor;
+    while (c < fim && (*c == ' ' || *c == '\t')) c++;
+    int negativo = c < fim && *c == '-';
+    if (negativo) c++;
+    if (c == fim || *c < '0' || *c > '9') return 0;
+    long long acumulado = 0;
+    while (c < fim && *c >= '0' && *c <= '9') {
+        if (acumulado < INT_MAX) acumulado = acumulado * 10 + (*c - '0');
+        c++;
+    }
+    *valor = negativo ? -acumulado : acumulado;
+    *cursor = c;
+    return 1;
+}
+
+// Trata uma linha recebida; retorna 1 se for a linha de encerramento "FIM"
+int receberLinhaVivo(EstadoVivo *estado, const char *linha, size_t tamanho) {
+    const char *fim = linha + tamanho;
+    while (fim > linha && (fim[-1] == '\r' || fim[-1] == ' ' || fim[-1] == '\t')) fim--;
+    while (linha < fim && (*linha == ' ' || *linha == '\t')) linha++;
+    if (linha == fim) return 0;
+    if (fim - linha == 3 && memcmp(linha, "FIM", 3) == 0) return 1;
+
+    long long chegada = agoraMicrossegundos();
+    long long numero, tamanhoPacote;
+    const char *cursor = linha;
+    if (!lerInteiroTexto(&cursor, fim, &numero) || !lerInteiroTexto(&cursor, fim, &tamanhoPacote) ||
+        numero > INT_MAX || numero < INT_MIN) {
+        estado->invalidos++;
+        return 0;
+    }
+    while (cursor < fim && (*cursor == ' ' || *cursor == '\t')) cursor++;
+    estado->recebidos++;
+
+    if (numero < estado->janela.base) {
+        estado->atrasados++;
+        return 0;
+    }
+    if (numeroNaJanela(&estado->janela, (int)numero)) {
+        estado->repetidos++;
+        return 0;
+    }
+    registrarHistograma(&estado->distancia, numero - estado->janela.base);
+    if (numero - estado->janela.base >= estado->limite) {
+        avancarJanelaAte(estado, (int)numero);
+    }
+
+    int indice = novoRegistroVivo(estado);
+    PacoteVivo *pacote = &estado->registros[indice];
+    size_t tamanhoDados = (size_t)(fim - cursor);
+    if (tamanhoDados > pacote->capacidade) {
+        pacote->dados = alocarOuSair(realloc(pacote->dados, tamanhoDados));
+        pacote->capacidade = tamanhoDados;
+    }
+    for (size_t k = 0; k < tamanhoDados; k++) {
+        pacote->dados[k] = cursor[k] == ' ' ? ',' : cursor[k];
+    }
+    pacote->tamanho = tamanhoDados;
+    pacote->chegada = chegada;
+    if (!inserirNaJanela(&estado->janela, (int)numero, indice)) {
+        fprintf(stderr, "Erro de alocação da janela de reordenação\n");
+        exit(1);
+    }
+    entregarEmSequencia(estado);
+    return 0;
+}
+
+// Trata as linhas completas de dados[0..tamanho); retorna quantos bytes foram consumidos
+size_t receberBlocoVivo(EstadoVivo *estado, const char *dados, size_t tamanho, int *encerrar) {
+    size_t consumidos = 0;
+    while (consumidos < tamanho && !*encerrar) {
+        const char *fimLinha = memchr(dados + consumidos, '\n', tamanho - consumidos);
+        if (!fimLinha) break;
+        *encerrar = receberLinhaVivo(estado, dados + consumidos, (size_t)(fimLinha - (dados + consumidos)));
+        consumidos = (size_t)(fimLinha - dados) + 1;
+    }
+    return consumidos;
+}
+
+// Começa a contar a espera da lacuna ou desiste dela quando o tempo acabou
+void verificarLacuna(EstadoVivo *estado, long long agora) {
+    if (janelaVazia(&estado->janela)) {
+        estado->inicioLacuna = -1;
+    } else if (estado->inicioLacuna < 0) {
+        estado->inicioLacuna = agora;
+    } else if (agora - estado->inicioLacuna >= estado->esperaUs) {
+        estado->lacunasPorTempo++;
+        desistirDaLacuna(estado);
+        estado->inicioLacuna = janelaVazia(&estado->janela) ? -1 : agora;
+    }
+}
+
+// Abre o socket UDP em 127.0.0.1 ou o FIFO; 'datagramas' indica se cada leitura é uma mensagem completa
+int abrirOrigemVivo(const char *origem, int *datagramas) {
+    if (strncmp(origem, "udp:", 4) == 0) {
+        int porta = atoi(origem + 4);
+        int descritor = socket(AF_INET, SOCK_DGRAM, 0);
+        if (descritor < 0 || porta <= 0 || porta > 65535) return -1;
+        struct sockaddr_in endereco;
+        memset(&endereco, 0, sizeof(endereco));
+        endereco.sin_family = AF_INET;
+        endereco.sin_port = htons((unsigned short)porta);
+        endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(descritor, (struct sockaddr *)&endereco, sizeof(endereco)) < 0) {
+            close(descritor);
+            return -1;
+        }
+        *datagramas = 1;
+        return descritor;
+    }
+    *datagramas = 0;
+    return open(origem, O_RDONLY);  // Num FIFO, espera o primeiro escritor
+}
+
+void processarAoVivo(char* origem, char* nomeArquivoSaida, int esperaMs, int limiteJanela) {
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = sinalParar;  // Sem SA_RESTART: o poll volta com EINTR
+    sigaction(SIGINT, &acao, NULL);
+    sigaction(SIGTERM, &acao, NULL);
+
+    int datagramas;
+    int descritor = abrirOrigemVivo(origem, &datagramas);
+    if (descritor < 0) {
+        perror("Erro ao abrir a origem dos pacotes");
+        exit(1);
+    }
+
+    static EstadoVivo estado;
+    if (!abrirEscritor(&estado.saida, nomeArquivoSaida)) {
+        perror("Erro ao abrir arquivo");
+        exit(1);
+    }
+    if (!iniciarJanela(&estado.janela, limiteJanela, 0)) alocarOuSair(NULL);
+    estado.primeiroLivre = -1;
+    estado.limite = limiteJanela;
+    estado.esperaUs = (long long)esperaMs * 1000;
+    estado.inicioLacuna = -1;
+    estado.latencia.titulo = "Latência de reordenação, da chegada até a escrita (us)";
+    estado.distancia.titulo = "Distância à frente do próximo esperado na chegada (pacotes)";
+
+    size_t capacidadeBuffer = TAMANHO_LEITURA_VIVO, pendentes = 0;
+    char *buffer = alocarOuSair(malloc(capacidadeBuffer));
+    int encerrar = 0;
+    while (!encerrar && !pararLeitura) {
+        int tempo = -1;
+        if (estado.inicioLacuna >= 0) {
+            long long restante = estado.inicioLacuna + estado.esperaUs - agoraMicrossegundos();
+            tempo = restante > 0 ? (int)((restante + 999) / 1000) : 0;
+        }
+        struct pollfd espera = {descritor, POLLIN, 0};
+        int prontos = poll(&espera, 1, tempo);
+        if (prontos < 0 && errno != EINTR) {
+            perror("Erro ao esperar pacotes");
+            break;
+        }
+
+        if (prontos > 0) {
+            if (datagramas) {
+                ssize_t lidos = recv(descritor, buffer, capacidadeBuffer - 1, 0);
+                if (lidos > 0) {
+                    buffer[lidos] = '\n';  // O fim do datagrama termina a última linha
+                    receberBlocoVivo(&estado, buffer, (size_t)lidos + 1, &encerrar);
+                }
+            } else {
+                if (pendentes == capacidadeBuffer) {
+                    capacidadeBuffer *= 2;
+                    buffer = alocarOuSair(realloc(buffer, capacidadeBuffer));
+                }
+                ssize_t lidos = read(descritor, buffer + pendentes, capacidadeBuffer - pendentes);
+                if (lidos < 0 && errno != EINTR) {
+                    perror("Erro ao ler pacotes");
+                    break;
+                }
+                if (lidos == 0) {
+                    if (pendentes > 0) receberLinhaVivo(&estado, buffer, pendentes);  // Última linha sem '\n'
+                    break;
+                }
+                if (lidos > 0) {
+                    pendentes += (size_t)lidos;
+                    size_t consumidos = receberBlocoVivo(&estado, buffer, pendentes, &encerrar);
+                    memmove(buffer, buffer + consumidos, pendentes - consumidos);
+                    pendentes -= consumidos;
+                }
+            }
+        }
+        verificarLacuna(&estado, agoraMicrossegundos());
+    }
+
+    // Fim da entrada: não há mais o que esperar, as lacunas restantes são perdidas
+    while (!janelaVazia(&estado.janela)) {
+        desistirDaLacuna(&estado);
+    }
+    if (!fecharEscritor(&estado.saida)) {
+        perror("Erro ao escrever arquivo de saída");
+    }
+    close(descritor);
+
+    fprintf(stderr, "Recebidos: %lld, entregues: %lld, atrasados: %lld, repetidos: %lld, perdidos: %lld, inválidos: %lld\n",
+            estado.recebidos, estado.entregues, estado.atrasados, estado.repetidos, estado.perdidos, estado.invalidos);
+    fprintf(stderr, "Lacunas encerradas por tempo: %lld\n", estado.lacunasPorTempo);
+    imprimirHistograma(&estado.latencia);
+    imprimirHistograma(&estado.distancia);
+
+    for (int i = 0; i < estado.quantidadeRegistros; i++) {
+        free(estado.registros[i].dados);
+    }
+    free(estado.registros);
+    free(buffer);
+    liberarJanela(&estado.janela);
+}
+#endif
+
+// Lê o resto da linha como " %[^\n]" (pula espaços e quebras de linha antes), sem limite de tamanho
+int lerLinha(FILE *arquivo, char **linha, size_t *capacidade, size_t *tamanho) {
+    int c;
+    do {
+        c = getc(arquivo);
+    } while (c != EOF && (c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f'));
+    if (c == EOF) return 0;
+
+    *tamanho = 0;
+    while (c != EOF && c != '\n') {
+        if (*tamanho + 1 >= *capacidade) {
+            size_t novaCapacidade = *capacidade ? *capacidade * 2 : 4096;
+            char *nova = realloc(*linha, novaCapacidade);
+            if (!nova) {
+                fprintf(stderr, "Erro de alocação\n");
+                exit(1);
+            }
+            *linha = nova;
+            *capacidade = novaCapacidade;
+        }
+        (*linha)[(*tamanho)++] = (char)c;
+        c = getc(arquivo);
+    }
+    if (c == '\n') ungetc(c, arquivo);
+    return 1;
 }
 
 // Função para processar a entrada e saída de dados
 void processarArquivoEntrada(char* nomeArquivoEntrada, char* nomeArquivoSaida) {
+#ifndef _WIN32
+    if (processarArquivoMapeado(nomeArquivoEntrada, nomeArquivoSaida)) {
+        return;
+    }
+#endif
     FILE* arquivoEntrada = fopen(nomeArquivoEntrada, "r");
-    FILE* arquivoSaida = fopen(nomeArquivoSaida, "w");
+    EscritorRapido saida;
 
     // Inicialização
-    if (!arquivoEntrada || !arquivoSaida) {
+    if (!arquivoEntrada || !abrirEscritor(&saida, nomeArquivoSaida)) {
         perror("Erro ao abrir arquivo");
         exit(1);
     }
 
-    char buffer[MAX_BYTES];
+    char *linha = NULL;
+    size_t capacidadeLinha = 0;
     int quantidadePacotes, quantidadePacotesBloco;
 
     if (fscanf(arquivoEntrada, "%d %d", &quantidadePacotes, &quantidadePacotesBloco) != 2) {
@@ -100,67 +1056,92 @@ void processarArquivoEntrada(char* nomeArquivoEntrada, char* nomeArquivoSaida) {
         exit(1);
     }
 
-    capacidadeHeap = quantidadePacotesBloco;
-    heapDePacotes = malloc(sizeof(Pacote) * capacidadeHeap);
+    iniciarReordenacao(quantidadePacotesBloco);
     int posicaoSequencia = 0;
 
     for (int i = 0; i < (quantidadePacotes + quantidadePacotesBloco - 1) / quantidadePacotesBloco; i++) {
         for (int j = 0; j < quantidadePacotesBloco; j++) {
             int numeroPacote, tamanhoPacote;
-            if (fscanf(arquivoEntrada, "%d %d %[^\n]", &numeroPacote, &tamanhoPacote, buffer) != 3) {
+            size_t tamanhoLinha;
+            if (fscanf(arquivoEntrada, "%d %d", &numeroPacote, &tamanhoPacote) != 2 ||
+                !lerLinha(arquivoEntrada, &linha, &capacidadeLinha, &tamanhoLinha)) {
                 break;
             }
 
-            // Adicionar vírgulas entre os bytes
-            char dadosFormatados[MAX_BYTES];
-            int k = 0;
-            for (int m = 0; buffer[m] != '\0'; m++) {
-                if (buffer[m] == ' ') {
-                    dadosFormatados[k++] = ',';
-                } else {
-                    dadosFormatados[k++] = buffer[m];
-                }
-            }
-            dadosFormatados[k] = '\0';
-
             Pacote p;
             p.numeroPrioridade = numeroPacote;
-            strcpy(p.dados, dadosFormatados);
-
-            inserirPacoteNoHeap(p);
+            p.slot = guardarDados(linha, tamanhoLinha);
+            inserirPacote(p);
         }
 
         int primeiraImpressao = 1;
-        while (!estaHeapVazia() && heapDePacotes[0].numeroPrioridade == posicaoSequencia) {
-            Pacote p = removerPacoteDoHeap();
-            if (primeiraImpressao) {
-                fprintf(arquivoSaida, "|%s", p.dados);
-                primeiraImpressao = 0;
-            } else {
-                fprintf(arquivoSaida, "|%s", p.dados);
-            }
+        Pacote p;
+        while (retirarProximoPacote(posicaoSequencia, &p)) {
+            escreverDados(&saida, p.slot);
+            primeiraImpressao = 0;
             posicaoSequencia++;
         }
         if (!primeiraImpressao) {
-            fprintf(arquivoSaida, "|\n");
+            escreverBytes(&saida, "|\n", 2);
+        }
+        if (usadoSlab > SLAB_MINIMO_COMPACTAR && usadoSlab > 2 * bytesVivosSlab) {
+            compactarSlab();
         }
     }
 
     fclose(arquivoEntrada);
-    fclose(arquivoSaida);
-    free(heapDePacotes);
+    if (!fecharEscritor(&saida)) {
+        perror("Erro ao escrever arquivo de saída");
+    }
+    liberarReordenacao();
+    free(slab);
+    free(linha);
 }
 
 // Função principal
 int main(int argc, char *argv[]) {
     // Verifica se a quantidade de argumentos está correta
-    if (argc != 3) {
-        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida>\n", argv[0]);
+    int threadsFluxos = 0;  // 0: um único fluxo (formato original)
+    int aoVivo = 0, esperaMs = ESPERA_PADRAO_MS, limiteJanela = LIMITE_PADRAO_JANELA;
+    int argumentosValidos = argc >= 3;
+    for (int i = 3; i < argc && argumentosValidos; i++) {
+        if (strcmp(argv[i], "-janela") == 0) {
+            usarJanela = 1;
+        } else if (strcmp(argv[i], "-fluxos") == 0 && i + 1 < argc) {
+            threadsFluxos = atoi(argv[++i]);
+            argumentosValidos = threadsFluxos >= 1 && threadsFluxos <= LIMITE_THREADS_FLUXOS;
+        } else if (strcmp(argv[i], "-ao-vivo") == 0) {
+            aoVivo = 1;
+        } else if (strcmp(argv[i], "-espera") == 0 && i + 1 < argc) {
+            esperaMs = atoi(argv[++i]);
+            argumentosValidos = esperaMs >= 0;
+        } else if (strcmp(argv[i], "-limite") == 0 && i + 1 < argc) {
+            limiteJanela = atoi(argv[++i]);
+            argumentosValidos = limiteJanela >= 1 && limiteJanela <= (1 << 24);
+        } else {
+            argumentosValidos = 0;
+        }
+    }
+    if (aoVivo && threadsFluxos > 0) argumentosValidos = 0;
+    if (!argumentosValidos) {
+        fprintf(stderr, "Uso: %s <arquivo_entrada> <arquivo_saida> [-janela] [-fluxos N]\n", argv[0]);
+        fprintf(stderr, "     %s <udp:PORTA | fifo> <arquivo_saida> -ao-vivo [-espera ms] [-limite N]\n", argv[0]);
         return 1;
     }
 
     // Processamento de entrada
-    processarArquivoEntrada(argv[1], argv[2]);
+    if (aoVivo) {
+#ifndef _WIN32
+        processarAoVivo(argv[1], argv[2], esperaMs, limiteJanela);
+#else
+        fprintf(stderr, "Modo ao vivo indisponível nesta plataforma\n");
+        return 1;
+#endif
+    } else if (threadsFluxos > 0) {
+        processarFluxos(argv[1], argv[2], threadsFluxos);
+    } else {
+        processarArquivoEntrada(argv[1], argv[2]);
+    }
 
     return 0;
 }
\ No newline at end of file
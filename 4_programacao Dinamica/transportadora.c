@@ -1,19 +1,36 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include <time.h>
+#include <pthread.h>
+#include <unistd.h>  // sysconf
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#include "../comum/escritorRapido.h" // Saída com buffer e conversão manual de inteiros
+// Compilar - gcc -O2 -o transportadora transportadora.c -pthread
 
 
 //-------------[ Definições e macros ]----------------
 
 #define TAMANHO_PLACA 8
 #define TAMANHO_CODIGO_PACOTE 14
-#define TOLERANCIA 1e-6
+#define ITENS_POR_BLOCO_DECISAO 64               // Base da divisão e conquista: um uint64 de decisões por estado
+#define LIMITE_BYTES_DECISOES ((size_t)1 << 30)  // Acima disso, a reconstrução usa divisão e conquista
+#define LIMITE_THREADS_MOCHILA 16                // Threads que dividem as linhas de peso de cada camada
+#define ESTADOS_MINIMOS_POR_THREAD 16384         // Camadas menores não compensam a barreira por item
+#define LIMITE_ATUALIZACOES_DP ((size_t)1 << 28) // Acima disso (itens x estados alcançáveis), tenta antes o branch-and-bound
+#define LIMITE_BYTES_CAMADA ((size_t)1 << 30)    // Camada DP maior que isso não cabe: só o branch-and-bound resolve
+#define ESTADOS_POR_NO_RAMIFICACAO 32            // Orçamento de nós do branch-and-bound: estados da camada / isto
+#define PASSOS_BUSCA_MULTIPLICADOR 60            // Iterações da busca ternária de cada multiplicador do branch-and-bound
 
 // Macro para calcular o valor absoluto
 #define valorAbsoluto(numero) ((numero) < 0 ? -(numero) : (numero))
 // Macro para arredondar um número para o inteiro mais próximo
 #define arredondar(valor) ((int)((valor) < 0 ? ((valor) - 0.5) : ((valor) + 0.5)))
+// O mesmo, em 64 bits (centavos)
+#define arredondarLongo(valor) ((int64_t)((valor) < 0 ? ((valor) - 0.5) : ((valor) + 0.5)))
 
 
 //-------------[ Estruturas ]---------------- 
@@ -25,6 +42,7 @@ typedef struct {
     int peso;
     int volume;
     float valor;
+    int64_t centavos; // Valor em centavos, usado na programação dinâmica
     int ordem;
     int disponivel; // 1 se disponível; 0 se já foi transportado
 } Pacote;
@@ -41,14 +59,42 @@ typedef struct {
     int quantidadeCargas;
 } Veiculo;
 
+// Pacote como item da mochila de um veículo (medidas já divididas pelo MDC)
+typedef struct {
+    int peso;
+    int volume;
+    int64_t centavos;  // Cabe em int32 nas camadas int32 (a soma dos itens do veículo cabe)
+} ItemMochila;
+
 
 //-------------[ Prototipação de funções ]----------------
 
 Pacote **resolverMochilaParaVeiculo(Veiculo *veiculo, Pacote **pacotesDisponiveis, int quantidadePacotesDisponiveis, int *quantidadePacotesEscolhidos);
+void resolverMochilaPorCamadas(const ItemMochila *itens, int quantidadeItens, int capacidadePesoMaxima, int capacidadeVolumeMaxima, char *escolhidos);
+void resolverMochilaPorDivisao(const ItemMochila *itens, int quantidadeItens, int capacidadePesoMaxima, int capacidadeVolumeMaxima, char *escolhidos);
+void resolverMochilaPorCamadasLongas(const ItemMochila *itens, int quantidadeItens, int capacidadePesoMaxima, int capacidadeVolumeMaxima, char *escolhidos);
+int resolverMochilaPorRamificacao(const ItemMochila *itens, int quantidadeItens, int capacidadePesoMaxima, int capacidadeVolumeMaxima, long long limiteNos, char *escolhidos);
 void liberarMemoria(Veiculo *vetorVeiculos, Pacote *todosPacotes, int numeroVeiculos, int quantidadeTotalPacotes);
 void processarArquivo(char *entrada, char *saida);
 void iniciarDadosVeiculo(Veiculo *veiculo, int pesoLimite, int volumeLimite);
 
+// -divisao: reconstrução por divisão e conquista em todos os veículos (sem a opção, só quando os bits
+// de decisão passariam de LIMITE_BYTES_DECISOES)
+int usarDivisao = 0;
+
+// -threads N: threads na atualização das camadas (0: uma por núcleo)
+int threadsMochila = 0;
+
+// -ramificacao: branch-and-bound em todos os veículos, sem limite de nós (sem a opção, só quando a DP
+// faria mais de LIMITE_ATUALIZACOES_DP atualizações de estado ou a camada não caberia na memória)
+int usarRamificacao = 0;
+
+// -dp: programação dinâmica em todos os veículos (nunca usa o branch-and-bound)
+int usarProgramacaoDinamica = 0;
+
+// -sem-reducao: desliga o MDC das capacidades, a poda de itens e os limites alcançáveis
+int usarReducao = 1;
+
 
 /*
    Função que resolve o problema da mochila (knapsack) com duas restrições
@@ -67,9 +113,22 @@ void iniciarDadosVeiculo(Veiculo *veiculo, int pesoLimite, int volumeLimite);
 
 int main(int argc, char **argv) {
     if (argc < 3) {
-        fprintf(stderr, "Uso: %s <entrada> <saida>\n", argv[0]);
+        fprintf(stderr, "Uso: %s <entrada> <saida> [-divisao] [-ramificacao | -dp] [-threads N] [-sem-reducao]\n", argv[0]);
         return 1;
     }
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "-divisao") == 0) {
+            usarDivisao = 1;
+        } else if (strcmp(argv[i], "-ramificacao") == 0) {
+            usarRamificacao = 1;
+        } else if (strcmp(argv[i], "-dp") == 0) {
+            usarProgramacaoDinamica = 1;
+        } else if (strcmp(argv[i], "-sem-reducao") == 0) {
+            usarReducao = 0;
+        } else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc) {
+            threadsMochila = atoi(argv[++i]);
+        }
+    }
 
     clock_t start = clock();
 
@@ -83,95 +142,932 @@ int main(int argc, char **argv) {
 }
 
 
-//--------------[ Função gera a tabela 3D e resolve o problema da mochila ]----------------
+//--------------[ Atualização das camadas em paralelo (threads por faixa de peso + SIMD em v) ]----------------
+
+/*
+   Com duas camadas (anterior e atual, trocadas a cada item), cada linha p da
+   camada atual depende só da camada anterior. As linhas são divididas em
+   faixas contíguas, uma por thread, e uma barreira separa os itens.
+
+   Os valores da tabela são inteiros em centavos (int32): a comparação é
+   exata e o empate continua favorecendo não incluir o item. Dentro da linha,
+   destino = max(anterior, origem deslocada + valor) é feito sem desvios, oito
+   estados por vez com AVX2 (quando disponível), e a máscara do max vira os
+   bits de decisão. Os bits de cada linha começam numa palavra nova
+   (palavrasPorLinha), assim duas threads nunca escrevem na mesma palavra.
+   Veículos cuja soma de centavos não cabe em int32 usam
+   resolverMochilaPorCamadasLongas.
+*/
+
+// Atualiza uma linha: destino[v] = max(anterior[v], origem[v - volumeItem] + valorItem), ligando o bit v
+// quando o item melhora o estado
+typedef void (*FuncaoAtualizarLinha)(int32_t *destino, const int32_t *anterior, const int32_t *origem,
+                                     int volumeMax, int volumeItem, int32_t valorItem, uint64_t *bits);
+
+static void atualizarLinhaEscalar(int32_t *destino, const int32_t *anterior, const int32_t *origem, int volumeMax,
+                                  int volumeItem, int32_t valorItem, uint64_t *bits) {
+    memcpy(destino, anterior, (size_t)volumeItem * sizeof(int32_t));
+    for (int v = volumeItem; v <= volumeMax; v++) {
+        int32_t candidato = origem[v - volumeItem] + valorItem;
+        int melhora = candidato > anterior[v];
+        destino[v] = melhora ? candidato : anterior[v];
+        bits[v >> 6] |= (uint64_t)melhora << (v & 63);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2")))
+static void atualizarLinhaAvx2(int32_t *destino, const int32_t *anterior, const int32_t *origem, int volumeMax,
+                               int volumeItem, int32_t valorItem, uint64_t *bits) {
+    memcpy(destino, anterior, (size_t)volumeItem * sizeof(int32_t));
+    const __m256i valor = _mm256_set1_epi32(valorItem);
+    int v = volumeItem;
+    for (; v + 8 <= volumeMax + 1; v += 8) {
+        __m256i candidato = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(origem + v - volumeItem)), valor);
+        __m256i atual = _mm256_loadu_si256((const __m256i *)(anterior + v));
+        _mm256_storeu_si256((__m256i *)(destino + v), _mm256_max_epi32(atual, candidato));
+        uint64_t mascara = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(candidato, atual)));
+        bits[v >> 6] |= mascara << (v & 63);
+        if ((v & 63) > 56) bits[(v >> 6) + 1] |= mascara >> (64 - (v & 63));
+    }
+    for (; v <= volumeMax; v++) {
+        int32_t candidato = origem[v - volumeItem] + valorItem;
+        int melhora = candidato > anterior[v];
+        destino[v] = melhora ? candidato : anterior[v];
+        bits[v >> 6] |= (uint64_t)melhora << (v & 63);
+    }
+}
+#endif
+
+static FuncaoAtualizarLinha escolherAtualizarLinha(void) {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return atualizarLinhaAvx2;
+#endif
+    return atualizarLinhaEscalar;
+}
+
+typedef struct TrabalhoMochila {
+    int32_t *camadas[2];        // camadas[i & 1]: camada antes do item i
+    uint64_t *decisoes;         // Bits do item i a partir de decisoes + i * palavrasPorItem
+    size_t palavrasPorLinha;
+    size_t palavrasPorItem;
+    const ItemMochila *itens;
+    int quantidadeItens;
+    const int *pesoAlcancavel;  // [i]: maior peso útil com os itens antes de i (0..quantidadeItens)
+    const int *volumeAlcancavel;
+    int pesoMax;
+    int volumeMax;
+    int quantidadeThreads;
+    FuncaoAtualizarLinha atualizarLinha;
+    pthread_barrier_t barreira;
+} TrabalhoMochila;
+
+typedef struct FaixaMochila {
+    TrabalhoMochila *trabalho;
+    int primeiraLinha;
+    int fimLinhas;              // Exclusivo
+} FaixaMochila;
+
+/*
+   Só a região alcançável da camada é calculada: depois do item i, as linhas
+   acima de pesoAlcancavel[i + 1] repetem a linha desse peso (e o mesmo vale
+   para as colunas de volume), então quem lê uma linha além do limite usa a
+   linha do limite. Cada linha é completada até o limite de volume do item
+   seguinte com o valor da última coluna calculada.
+*/
+static void *atualizarFaixa(void *argumento) {
+    FaixaMochila *faixa = argumento;
+    TrabalhoMochila *trabalho = faixa->trabalho;
+    size_t dimensaoVolume = (size_t)trabalho->volumeMax + 1;
+    for (int i = 0; i < trabalho->quantidadeItens; i++) {
+        const int32_t *anterior = trabalho->camadas[i & 1];
+        int32_t *atual = trabalho->camadas[(i & 1) ^ 1];
+        const ItemMochila *item = &trabalho->itens[i];
+        uint64_t *bitsItem = trabalho->decisoes + (size_t)i * trabalho->palavrasPorItem;
+        int pesoAnterior = trabalho->pesoAlcancavel[i];
+        int pesoAtual = trabalho->pesoAlcancavel[i + 1];
+        int volumeAtual = trabalho->volumeAlcancavel[i + 1];
+        int volumeSeguinte = i + 1 < trabalho->quantidadeItens ? trabalho->volumeAlcancavel[i + 2] : volumeAtual;
+        int fimLinhas = faixa->fimLinhas <= pesoAtual ? faixa->fimLinhas : pesoAtual + 1;
+        for (int p = faixa->primeiraLinha; p < fimLinhas; p++) {
+            int32_t *destino = atual + p * dimensaoVolume;
+            const int32_t *linhaAnterior = anterior + (p < pesoAnterior ? p : pesoAnterior) * dimensaoVolume;
+            if (p < item->peso || item->volume > volumeAtual) {
+                memcpy(destino, linhaAnterior, ((size_t)volumeAtual + 1) * sizeof(int32_t));  // O item não cabe em nenhum v
+            } else {
+                int linhaOrigem = p - item->peso < pesoAnterior ? p - item->peso : pesoAnterior;
+                trabalho->atualizarLinha(destino, linhaAnterior, anterior + linhaOrigem * dimensaoVolume, volumeAtual,
+                                         item->volume, item->centavos, bitsItem + p * trabalho->palavrasPorLinha);
+            }
+            for (int v = volumeAtual + 1; v <= volumeSeguinte; v++) {
+                destino[v] = destino[volumeAtual];
+            }
+        }
+        if (trabalho->quantidadeThreads > 1) pthread_barrier_wait(&trabalho->barreira);
+    }
+    return NULL;
+}
+
+// Quantas threads usar numa camada de dimensaoPeso x dimensaoVolume estados
+// (no modo automático, camadas pequenas ficam com menos threads ou só com a principal)
+static int threadsParaCamada(int dimensaoPeso, size_t estados) {
+    int quantidade = threadsMochila;
+    if (quantidade <= 0) {
+        quantidade = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        if (nucleos > 0) quantidade = (int)nucleos;
+#endif
+        if ((size_t)quantidade > estados / ESTADOS_MINIMOS_POR_THREAD) {
+            quantidade = (int)(estados / ESTADOS_MINIMOS_POR_THREAD);
+        }
+    }
+    if (quantidade > LIMITE_THREADS_MOCHILA) quantidade = LIMITE_THREADS_MOCHILA;
+    if (quantidade > dimensaoPeso) quantidade = dimensaoPeso;
+    return quantidade > 1 ? quantidade : 1;
+}
+
+// Processa todos os itens sobre 'camadas' (a camada 0 zerada em camadas[0]) e preenche 'decisoes'
+static void calcularCamadasEmParalelo(TrabalhoMochila *trabalho) {
+    static FuncaoAtualizarLinha atualizarLinha = NULL;
+    if (!atualizarLinha) atualizarLinha = escolherAtualizarLinha();
+    trabalho->atualizarLinha = atualizarLinha;
+
+    int dimensaoPeso = trabalho->pesoMax + 1;
+    int quantidadeThreads = threadsParaCamada(dimensaoPeso, (size_t)dimensaoPeso * (trabalho->volumeMax + 1));
+    trabalho->quantidadeThreads = quantidadeThreads;
+
+    FaixaMochila faixas[LIMITE_THREADS_MOCHILA];
+    for (int t = 0; t < quantidadeThreads; t++) {
+        faixas[t].trabalho = trabalho;
+        faixas[t].primeiraLinha = (int)((long long)dimensaoPeso * t / quantidadeThreads);
+        faixas[t].fimLinhas = (int)((long long)dimensaoPeso * (t + 1) / quantidadeThreads);
+    }
+    if (quantidadeThreads == 1) {
+        atualizarFaixa(&faixas[0]);
+        return;
+    }
+
+    pthread_t threads[LIMITE_THREADS_MOCHILA];
+    pthread_barrier_init(&trabalho->barreira, NULL, (unsigned)quantidadeThreads);
+    for (int t = 1; t < quantidadeThreads; t++) {
+        if (pthread_create(&threads[t], NULL, atualizarFaixa, &faixas[t]) != 0) {
+            perror("Erro ao criar thread da mochila");
+            exit(EXIT_FAILURE);
+        }
+    }
+    atualizarFaixa(&faixas[0]);  // A thread principal fica com a primeira faixa
+    for (int t = 1; t < quantidadeThreads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    pthread_barrier_destroy(&trabalho->barreira);
+}
+
+
+//--------------[ Redução da instância (MDC das capacidades e itens que nunca entram) ]----------------
+
+/*
+   Antes da programação dinâmica de cada veículo:
+     - saem os pacotes que não cabem sozinhos ou têm valor <= 0: eles nunca
+       melhoram estritamente um estado, então a tabela e o desempate não mudam;
+     - pesos, volumes e limites são divididos pelo MDC dos pesos (e dos
+       volumes) dos pacotes restantes; o limite é arredondado para baixo, o
+       que não muda nenhuma escolha;
+     - cada limite fica no máximo igual à soma das medidas dos pacotes: acima
+       dela a DP é constante, e a reconstrução lê os mesmos bits;
+     - pesoAlcancavel[i] e volumeAlcancavel[i] limitam as camadas à soma dos
+       itens anteriores a i (ou ao limite, se for menor).
+   A opção -sem-reducao desliga tudo isso (para comparação).
+*/
+
+static int maximoDivisorComum(int a, int b) {
+    while (b != 0) {
+        int resto = a % b;
+        a = b;
+        b = resto;
+    }
+    return a;
+}
+
+// Preenche 'itens' (e o pacote de cada um em 'origens') e as capacidades reduzidas; retorna a quantidade de itens
+static int reduzirInstancia(const Veiculo *veiculo, Pacote **pacotes, int quantidadePacotes, ItemMochila *itens,
+                            Pacote **origens, int *pesoMax, int *volumeMax) {
+    int quantidadeItens = 0;
+    int mdcPeso = 0, mdcVolume = 0;
+    for (int i = 0; i < quantidadePacotes; i++) {
+        Pacote *pacote = pacotes[i];
+        if (usarReducao && (pacote->peso > veiculo->pesoLimite || pacote->volume > veiculo->volumeLimite ||
+                            pacote->centavos <= 0)) {
+            continue;
+        }
+        itens[quantidadeItens].peso = pacote->peso;
+        itens[quantidadeItens].volume = pacote->volume;
+        itens[quantidadeItens].centavos = pacote->centavos;
+        origens[quantidadeItens++] = pacote;
+        mdcPeso = maximoDivisorComum(mdcPeso, pacote->peso);
+        mdcVolume = maximoDivisorComum(mdcVolume, pacote->volume);
+    }
+
+    *pesoMax = veiculo->pesoLimite;
+    *volumeMax = veiculo->volumeLimite;
+    if (!usarReducao) return quantidadeItens;
+
+    // MDC 0: todos os pesos (ou volumes) são 0 e o limite não restringe nada
+    *pesoMax = mdcPeso > 0 ? *pesoMax / mdcPeso : 0;
+    *volumeMax = mdcVolume > 0 ? *volumeMax / mdcVolume : 0;
+    long long somaPesos = 0, somaVolumes = 0;
+    for (int i = 0; i < quantidadeItens; i++) {
+        if (mdcPeso > 0) itens[i].peso /= mdcPeso;
+        if (mdcVolume > 0) itens[i].volume /= mdcVolume;
+        somaPesos += itens[i].peso;
+        somaVolumes += itens[i].volume;
+    }
+    if (somaPesos < *pesoMax) *pesoMax = (int)somaPesos;
+    if (somaVolumes < *volumeMax) *volumeMax = (int)somaVolumes;
+    return quantidadeItens;
+}
+
+// Limites das camadas: alcancavel[i] = min(limite, soma das medidas dos itens antes de i), i = 0..quantidadeItens
+static void calcularAlcancaveis(const ItemMochila *itens, int quantidadeItens, int pesoMax, int volumeMax,
+                                int *pesoAlcancavel, int *volumeAlcancavel) {
+    pesoAlcancavel[0] = usarReducao ? 0 : pesoMax;
+    volumeAlcancavel[0] = usarReducao ? 0 : volumeMax;
+    for (int i = 0; i < quantidadeItens; i++) {
+        int peso = pesoAlcancavel[i] + itens[i].peso;
+        int volume = volumeAlcancavel[i] + itens[i].volume;
+        pesoAlcancavel[i + 1] = peso < pesoMax ? peso : pesoMax;
+        volumeAlcancavel[i + 1] = volume < volumeMax ? volume : volumeMax;
+    }
+}
+
+
+//--------------[ Função resolve o problema da mochila (camadas DP + bits de decisão) ]----------------
 
 Pacote **resolverMochilaParaVeiculo(Veiculo *veiculo, Pacote **pacotesDisponiveis, int quantidadePacotesDisponiveis, int *quantidadePacotesEscolhidos) {
-    int capacidadePesoMaxima  = veiculo->pesoLimite;
-    int capacidadeVolumeMaxima = veiculo->volumeLimite;
+    ItemMochila *itens = malloc((quantidadePacotesDisponiveis + 1) * sizeof(ItemMochila));
+    Pacote **origens = malloc((quantidadePacotesDisponiveis + 1) * sizeof(Pacote *));
+    char *escolhidos = calloc(quantidadePacotesDisponiveis + 1, sizeof(char));
+    Pacote **vetorPacotesEscolhidos = malloc((quantidadePacotesDisponiveis + 1) * sizeof(Pacote *));
+    if (itens == NULL || origens == NULL || escolhidos == NULL || vetorPacotesEscolhidos == NULL) {
+        perror("Erro na alocacao dos itens da mochila");
+        exit(EXIT_FAILURE);
+    }
+
+    int capacidadePesoMaxima, capacidadeVolumeMaxima;
+    int quantidadeItens = reduzirInstancia(veiculo, pacotesDisponiveis, quantidadePacotesDisponiveis, itens, origens,
+                                           &capacidadePesoMaxima, &capacidadeVolumeMaxima);
+
+    if (quantidadeItens > 0) {
+        // Estados que os itens alcançam (com a redução, os limites já foram limitados à soma dos itens)
+        long long somaPesos = 0, somaVolumes = 0;
+        for (int i = 0; i < quantidadeItens; i++) {
+            somaPesos += itens[i].peso;
+            somaVolumes += itens[i].volume;
+        }
+        size_t estadosAlcancaveis = (size_t)((somaPesos < capacidadePesoMaxima ? somaPesos : capacidadePesoMaxima) + 1) *
+                                    (size_t)((somaVolumes < capacidadeVolumeMaxima ? somaVolumes : capacidadeVolumeMaxima) + 1);
+
+        // O maior valor da tabela é a soma dos centavos dos itens (todos positivos depois da redução):
+        // acima de int32, as camadas passam a int64
+        long long somaCentavos = 0;
+        for (int i = 0; i < quantidadeItens; i++) {
+            somaCentavos += valorAbsoluto(itens[i].centavos);
+        }
+        int valoresLongos = somaCentavos > INT32_MAX;
+        size_t bytesPorEstado = valoresLongos ? sizeof(int64_t) : sizeof(int32_t);
 
-    // Dimensões para a tabela DP:
-    int dimensaoItens  = quantidadePacotesDisponiveis + 1;       // Camadas: 0 (nenhum item) até n
+        // Branch-and-bound: sem limite de nós quando forçado ou quando nem uma camada DP cabe; com a DP ainda
+        // possível mas cara, com um orçamento de nós proporcional a ela, voltando para a DP se ele acabar
+        int resolvido = 0;
+        if (!usarProgramacaoDinamica) {
+            if (usarRamificacao || estadosAlcancaveis > LIMITE_BYTES_CAMADA / bytesPorEstado) {
+                resolvido = resolverMochilaPorRamificacao(itens, quantidadeItens, capacidadePesoMaxima,
+                                                          capacidadeVolumeMaxima, -1, escolhidos);
+            } else if (estadosAlcancaveis > LIMITE_ATUALIZACOES_DP / quantidadeItens) {
+                resolvido = resolverMochilaPorRamificacao(itens, quantidadeItens, capacidadePesoMaxima,
+                                                          capacidadeVolumeMaxima,
+                                                          (long long)(estadosAlcancaveis / ESTADOS_POR_NO_RAMIFICACAO),
+                                                          escolhidos);
+            }
+        }
+
+        // Bits de decisão grandes demais: reconstrói guardando só camadas
+        size_t bytesDecisoes = (size_t)quantidadeItens * (capacidadePesoMaxima + 1) *
+                               (((size_t)capacidadeVolumeMaxima + 64) / 64) * sizeof(uint64_t);
+        if (resolvido) {
+            // Carga já marcada pelo branch-and-bound
+        } else if (valoresLongos) {
+            // Sem divisão e conquista em int64: com bits grandes demais, o branch-and-bound resolve sem limite
+            if (!usarProgramacaoDinamica && bytesDecisoes > LIMITE_BYTES_DECISOES) {
+                resolverMochilaPorRamificacao(itens, quantidadeItens, capacidadePesoMaxima, capacidadeVolumeMaxima,
+                                              -1, escolhidos);
+            } else {
+                resolverMochilaPorCamadasLongas(itens, quantidadeItens, capacidadePesoMaxima, capacidadeVolumeMaxima,
+                                                escolhidos);
+            }
+        } else if (usarDivisao || bytesDecisoes > LIMITE_BYTES_DECISOES) {
+            resolverMochilaPorDivisao(itens, quantidadeItens, capacidadePesoMaxima, capacidadeVolumeMaxima, escolhidos);
+        } else {
+            resolverMochilaPorCamadas(itens, quantidadeItens, capacidadePesoMaxima, capacidadeVolumeMaxima, escolhidos);
+        }
+    }
+
+    // Pacotes escolhidos na sequência original
+    int contador = 0;
+    for (int i = 0; i < quantidadeItens; i++) {
+        if (escolhidos[i]) vetorPacotesEscolhidos[contador++] = origens[i];
+    }
+
+    free(itens);
+    free(origens);
+    free(escolhidos);
+    *quantidadePacotesEscolhidos = contador;
+    return vetorPacotesEscolhidos;
+}
+
+// Marca em 'escolhidos' a solução ótima dos itens com capacidades pesoMax x volumeMax
+void resolverMochilaPorCamadas(const ItemMochila *itens, int quantidadeItens, int capacidadePesoMaxima, int capacidadeVolumeMaxima, char *escolhidos) {
+    // Dimensões das camadas DP (reaproveitadas por todos os itens):
     int dimensaoPeso   = capacidadePesoMaxima + 1;                // 0 ... capacidadePesoMaxima
     int dimensaoVolume = capacidadeVolumeMaxima + 1;              // 0 ... capacidadeVolumeMaxima
-    int tamanhoPorItem = dimensaoPeso * dimensaoVolume;           // Tamanho de cada camada (DP[i])
-    int tamanhoTotal   = dimensaoItens * tamanhoPorItem;           // Tabela inteira
+    size_t tamanhoPorItem = (size_t)dimensaoPeso * dimensaoVolume; // Estados (p, v) de uma camada
 
-    // Aloca a tabela DP em um vetor unidimensional (inicialmente zerado)
-    float *tabelaDP = calloc(tamanhoTotal, sizeof(float));
-    if (tabelaDP == NULL) {
+    // Duas camadas DP, anterior e atual (a primeira zerada: camada 0, nenhum item)
+    int32_t *camadasDP = malloc(2 * tamanhoPorItem * sizeof(int32_t));
+    if (camadasDP == NULL) {
         perror("Erro na alocacao da tabela DP");
         exit(EXIT_FAILURE);
     }
+    memset(camadasDP, 0, tamanhoPorItem * sizeof(int32_t));
+
+    // Decisões: 1 bit por (item, p, v), ligado quando o item i melhora o estado (p, v).
+    // Substitui as n+1 camadas de int32 usadas só na reconstrução (32 vezes menos memória).
+    size_t palavrasPorLinha = ((size_t)dimensaoVolume + 63) / 64;
+    size_t palavrasPorItem = (size_t)dimensaoPeso * palavrasPorLinha;
+    uint64_t *decisoes = calloc((size_t)quantidadeItens * palavrasPorItem, sizeof(uint64_t));
+    int *pesoAlcancavel = malloc((quantidadeItens + 1) * sizeof(int));
+    int *volumeAlcancavel = malloc((quantidadeItens + 1) * sizeof(int));
+    if (decisoes == NULL || pesoAlcancavel == NULL || volumeAlcancavel == NULL) {
+        perror("Erro na alocacao da tabela de decisoes");
+        exit(EXIT_FAILURE);
+    }
+    calcularAlcancaveis(itens, quantidadeItens, capacidadePesoMaxima, capacidadeVolumeMaxima,
+                        pesoAlcancavel, volumeAlcancavel);
+
+    // Bit de decisão do item i (0..n-1) no estado (p, v)
+    #define DECISAO(i, p, v) \
+        ((decisoes[(size_t)(i) * palavrasPorItem + (size_t)(p) * palavrasPorLinha + ((v) >> 6)] >> ((v) & 63)) & 1)
+
+    // Processa os itens camada a camada, dividindo as linhas de peso entre threads
+    TrabalhoMochila trabalho;
+    memset(&trabalho, 0, sizeof(trabalho));
+    trabalho.camadas[0] = camadasDP;
+    trabalho.camadas[1] = camadasDP + tamanhoPorItem;
+    trabalho.decisoes = decisoes;
+    trabalho.palavrasPorLinha = palavrasPorLinha;
+    trabalho.palavrasPorItem = palavrasPorItem;
+    trabalho.itens = itens;
+    trabalho.quantidadeItens = quantidadeItens;
+    trabalho.pesoAlcancavel = pesoAlcancavel;
+    trabalho.volumeAlcancavel = volumeAlcancavel;
+    trabalho.pesoMax = capacidadePesoMaxima;
+    trabalho.volumeMax = capacidadeVolumeMaxima;
+    calcularCamadasEmParalelo(&trabalho);
+
+    // Reconstrução da solução ótima (backtracking): percorre os itens de trás para frente; o item foi
+    // incluído se melhorou o estado restante (o mesmo que DP(i) diferir de DP(i-1) nesse estado na
+    // tabela completa). Além da região alcançável, o bit é o do limite dela.
+    int pesoRestante = capacidadePesoMaxima;
+    int volRestante  = capacidadeVolumeMaxima;
+    for (int i = quantidadeItens - 1; i >= 0; i--) {
+        int p = pesoRestante < pesoAlcancavel[i + 1] ? pesoRestante : pesoAlcancavel[i + 1];
+        int v = volRestante < volumeAlcancavel[i + 1] ? volRestante : volumeAlcancavel[i + 1];
+        if (DECISAO(i, p, v)) {
+            escolhidos[i] = 1;
+            pesoRestante -= itens[i].peso;
+            volRestante  -= itens[i].volume;
+        }
+    }
+
+    free(camadasDP);
+    free(decisoes);
+    free(pesoAlcancavel);
+    free(volumeAlcancavel);
 
-    // Cria um vetor auxiliar 1-indexado para os pacotes (facilitando o acesso)
-    Pacote **vetorPacotesAux = malloc((quantidadePacotesDisponiveis + 1) * sizeof(Pacote *));
-    if (vetorPacotesAux == NULL) {
-        perror("Erro na alocacao do vetor auxiliar de pacotes");
+    #undef DECISAO
+}
+
+
+//--------------[ Camadas int64 (soma dos centavos acima de int32) ]----------------
+
+/*
+   Mesma tabela de resolverMochilaPorCamadas (região alcançável, bits de
+   decisão e reconstrução), com valores int64 e uma thread só, sem AVX2.
+   Só é usada quando a soma dos centavos dos itens do veículo passa de
+   INT32_MAX, o que as entradas comuns nunca alcançam.
+*/
+
+// Marca em 'escolhidos' a solução ótima, como resolverMochilaPorCamadas
+void resolverMochilaPorCamadasLongas(const ItemMochila *itens, int quantidadeItens, int capacidadePesoMaxima, int capacidadeVolumeMaxima, char *escolhidos) {
+    size_t dimensaoVolume = (size_t)capacidadeVolumeMaxima + 1;
+    size_t tamanhoPorItem = (size_t)(capacidadePesoMaxima + 1) * dimensaoVolume;
+    size_t palavrasPorLinha = (dimensaoVolume + 63) / 64;
+    size_t palavrasPorItem = (size_t)(capacidadePesoMaxima + 1) * palavrasPorLinha;
+    int64_t *camadas[2];
+    camadas[0] = calloc(2 * tamanhoPorItem, sizeof(int64_t));
+    camadas[1] = camadas[0] + tamanhoPorItem;
+    uint64_t *decisoes = calloc((size_t)quantidadeItens * palavrasPorItem, sizeof(uint64_t));
+    int *pesoAlcancavel = malloc((quantidadeItens + 1) * sizeof(int));
+    int *volumeAlcancavel = malloc((quantidadeItens + 1) * sizeof(int));
+    if (camadas[0] == NULL || decisoes == NULL || pesoAlcancavel == NULL || volumeAlcancavel == NULL) {
+        perror("Erro na alocacao da tabela DP int64");
         exit(EXIT_FAILURE);
     }
-    for (int i = 1; i <= quantidadePacotesDisponiveis; i++) {
-        vetorPacotesAux[i] = pacotesDisponiveis[i - 1];
+    calcularAlcancaveis(itens, quantidadeItens, capacidadePesoMaxima, capacidadeVolumeMaxima,
+                        pesoAlcancavel, volumeAlcancavel);
+
+    // Como atualizarFaixa, com todas as linhas numa faixa só
+    for (int i = 0; i < quantidadeItens; i++) {
+        const int64_t *anterior = camadas[i & 1];
+        int64_t *atual = camadas[(i & 1) ^ 1];
+        const ItemMochila *item = &itens[i];
+        uint64_t *bitsItem = decisoes + (size_t)i * palavrasPorItem;
+        int pesoAnterior = pesoAlcancavel[i];
+        int pesoAtual = pesoAlcancavel[i + 1];
+        int volumeAtual = volumeAlcancavel[i + 1];
+        int volumeSeguinte = i + 1 < quantidadeItens ? volumeAlcancavel[i + 2] : volumeAtual;
+        for (int p = 0; p <= pesoAtual; p++) {
+            int64_t *destino = atual + p * dimensaoVolume;
+            const int64_t *linhaAnterior = anterior + (p < pesoAnterior ? p : pesoAnterior) * dimensaoVolume;
+            if (p < item->peso || item->volume > volumeAtual) {
+                memcpy(destino, linhaAnterior, ((size_t)volumeAtual + 1) * sizeof(int64_t));
+            } else {
+                int linhaOrigem = p - item->peso < pesoAnterior ? p - item->peso : pesoAnterior;
+                const int64_t *origem = anterior + linhaOrigem * dimensaoVolume;
+                uint64_t *bits = bitsItem + p * palavrasPorLinha;
+                memcpy(destino, linhaAnterior, (size_t)item->volume * sizeof(int64_t));
+                for (int v = item->volume; v <= volumeAtual; v++) {
+                    int64_t candidato = origem[v - item->volume] + item->centavos;
+                    int melhora = candidato > linhaAnterior[v];
+                    destino[v] = melhora ? candidato : linhaAnterior[v];
+                    bits[v >> 6] |= (uint64_t)melhora << (v & 63);
+                }
+            }
+            for (int v = volumeAtual + 1; v <= volumeSeguinte; v++) {
+                destino[v] = destino[volumeAtual];
+            }
+        }
+    }
+
+    int pesoRestante = capacidadePesoMaxima;
+    int volRestante  = capacidadeVolumeMaxima;
+    for (int i = quantidadeItens - 1; i >= 0; i--) {
+        int p = pesoRestante < pesoAlcancavel[i + 1] ? pesoRestante : pesoAlcancavel[i + 1];
+        int v = volRestante < volumeAlcancavel[i + 1] ? volRestante : volumeAlcancavel[i + 1];
+        if ((decisoes[(size_t)i * palavrasPorItem + (size_t)p * palavrasPorLinha + (v >> 6)] >> (v & 63)) & 1) {
+            escolhidos[i] = 1;
+            pesoRestante -= itens[i].peso;
+            volRestante  -= itens[i].volume;
+        }
     }
 
-    // Macro para acessar a tabela DP: DP(i, p, v)
-    // Índice calculado como: (i * (dimensaoPeso * dimensaoVolume)) + (p * dimensaoVolume) + (v)
-    #define DP(i, p, v) tabelaDP[(i) * tamanhoPorItem + (p) * dimensaoVolume + (v)]
+    free(camadas[0]);
+    free(decisoes);
+    free(pesoAlcancavel);
+    free(volumeAlcancavel);
+}
+
 
-    // A camada 0 já está zerada (calloc). Processa cada item (camada de 1 a n)
-    for (int i = 1; i <= quantidadePacotesDisponiveis; i++) {
-        // Copia toda a camada anterior (i-1) para a camada atual (i)
-        memcpy(&DP(i, 0, 0), &DP(i - 1, 0, 0), sizeof(float) * tamanhoPorItem);
+//--------------[ Reconstrução por divisão e conquista (opção -divisao) ]----------------
 
-        // Obtém as propriedades do item atual em variáveis locais
-        Pacote *pacoteAtual = vetorPacotesAux[i];
-        int pesoItem   = pacoteAtual->peso;
-        int volumeItem = pacoteAtual->volume;
-        float valorItem = pacoteAtual->valor;
+/*
+   Para veículos em que até um bit por (item, p, v) não cabe na memória, a
+   reconstrução divide os itens ao meio recursivamente e guarda só camadas DP:
+     - a camada do ponto médio é calculada a partir da camada base do intervalo;
+     - a metade de cima é reconstruída a partir dela, começando no estado atual,
+       o que dá o estado restante no ponto médio;
+     - a metade de baixo é reconstruída a partir da camada base, limitada a esse
+       estado (as capacidades acima dele não influenciam o caminho).
+   Intervalos com até ITENS_POR_BLOCO_DECISAO itens são resolvidos com um
+   uint64 de decisões por estado. Cada camada é calculada com as mesmas
+   operações inteiras da tabela completa, então o caminho (e o desempate) é
+   exatamente o da reconstrução normal. Como no caminho normal, só a região
+   alcançável (pesoAlcancavel/volumeAlcancavel) é calculada, e cada intervalo
+   limita o estado de entrada ao alcançável no seu fim, o que também encolhe
+   as camadas copiadas. Memória: uma camada por nível da recursão,
+   O(W·V·log(n/64)); tempo: cerca de 1 + log2(n/64)/2 vezes a passada única,
+   menos o que se ganha limitando as capacidades.
+*/
+
+// Atualiza 'camada' (capacidades 0..pesoMax x 0..volumeMax, linhas de 'passo' valores) com os itens [inicio, fim).
+// A camada só precisa estar correta até os limites alcançáveis em 'inicio'; antes de cada item, as linhas e colunas
+// que passam a ser alcançáveis repetem a última linha e coluna calculadas. Com 'decisoes', liga o bit (i - inicio)
+// do estado quando o item i o melhora (só dentro da região alcançável).
+static void avancarCamada(int32_t *camada, int pesoMax, int volumeMax, int passo, const ItemMochila *itens, int inicio,
+                          int fim, const int *pesoAlcancavel, const int *volumeAlcancavel, uint64_t *decisoes) {
+    for (int i = inicio; i < fim; i++) {
+        int pesoItem   = itens[i].peso;
+        int volumeItem = itens[i].volume;
+        int32_t valorItem = itens[i].centavos;
+        int pesoAnterior   = pesoAlcancavel[i] < pesoMax ? pesoAlcancavel[i] : pesoMax;
+        int pesoAtual      = pesoAlcancavel[i + 1] < pesoMax ? pesoAlcancavel[i + 1] : pesoMax;
+        int volumeAnterior = volumeAlcancavel[i] < volumeMax ? volumeAlcancavel[i] : volumeMax;
+        int volumeAtual    = volumeAlcancavel[i + 1] < volumeMax ? volumeAlcancavel[i + 1] : volumeMax;
+
+        for (int p = 0; p <= pesoAnterior; p++) {
+            int32_t *linha = camada + (size_t)p * passo;
+            for (int v = volumeAnterior + 1; v <= volumeAtual; v++) {
+                linha[v] = linha[volumeAnterior];
+            }
+        }
+        for (int p = pesoAnterior + 1; p <= pesoAtual; p++) {
+            memcpy(camada + (size_t)p * passo, camada + (size_t)pesoAnterior * passo,
+                   ((size_t)volumeAtual + 1) * sizeof(int32_t));
+        }
 
-        // Atualiza somente os estados onde o item cabe (p >= pesoItem e v >= volumeItem)
-        for (int p = pesoItem; p <= capacidadePesoMaxima; p++) {
-            for (int v = volumeItem; v <= capacidadeVolumeMaxima; v++) {
-                float candidato = DP(i - 1, p - pesoItem, v - volumeItem) + valorItem;
-                if (candidato > DP(i, p, v) + TOLERANCIA) {
-                    DP(i, p, v) = candidato;
+        for (int p = pesoAtual; p >= pesoItem; p--) {
+            for (int v = volumeAtual; v >= volumeItem; v--) {
+                int32_t candidato = camada[(size_t)(p - pesoItem) * passo + (v - volumeItem)] + valorItem;
+                if (candidato > camada[(size_t)p * passo + v]) {
+                    camada[(size_t)p * passo + v] = candidato;
+                    if (decisoes) decisoes[(size_t)p * passo + v] |= 1ULL << (i - inicio);
                 }
             }
         }
     }
+}
+
+// Copia a parte 0..pesoMax x 0..volumeMax da camada para um vetor novo com linhas de volumeMax + 1 valores
+static int32_t *copiarCamada(const int32_t *camada, int pesoMax, int volumeMax, int passo) {
+    int32_t *copia = malloc((size_t)(pesoMax + 1) * (volumeMax + 1) * sizeof(int32_t));
+    if (copia == NULL) {
+        perror("Erro na alocacao da camada DP");
+        exit(EXIT_FAILURE);
+    }
+    for (int p = 0; p <= pesoMax; p++) {
+        memcpy(copia + (size_t)p * (volumeMax + 1), camada + (size_t)p * passo, (volumeMax + 1) * sizeof(int32_t));
+    }
+    return copia;
+}
+
+// Marca em 'escolhidos' os itens de [inicio, fim) que a reconstrução escolhe a partir do estado (*peso, *volume),
+// sendo 'base' a camada DP dos itens anteriores a 'inicio'. Ao final, (*peso, *volume) é o estado em 'inicio'.
+static void reconstruirIntervalo(const int32_t *base, int passo, const ItemMochila *itens, int inicio, int fim,
+                                 const int *pesoAlcancavel, const int *volumeAlcancavel, int *peso, int *volume,
+                                 char *escolhidos) {
+    // Acima do alcançável em 'fim', os itens do intervalo decidem como no limite: trabalha no limite e
+    // devolve a sobra no final
+    int sobraPeso = *peso > pesoAlcancavel[fim] ? *peso - pesoAlcancavel[fim] : 0;
+    int sobraVolume = *volume > volumeAlcancavel[fim] ? *volume - volumeAlcancavel[fim] : 0;
+    *peso -= sobraPeso;
+    *volume -= sobraVolume;
+
+    int pesoMax = *peso, volumeMax = *volume;
+    if (fim - inicio <= ITENS_POR_BLOCO_DECISAO) {
+        int32_t *camada = copiarCamada(base, pesoMax, volumeMax, passo);
+        uint64_t *decisoes = calloc((size_t)(pesoMax + 1) * (volumeMax + 1), sizeof(uint64_t));
+        if (decisoes == NULL) {
+            perror("Erro na alocacao da tabela de decisoes");
+            exit(EXIT_FAILURE);
+        }
+        avancarCamada(camada, pesoMax, volumeMax, volumeMax + 1, itens, inicio, fim, pesoAlcancavel,
+                      volumeAlcancavel, decisoes);
+        for (int i = fim - 1; i >= inicio; i--) {
+            // Bit do item i no estado limitado ao alcançável depois dele
+            int p = *peso < pesoAlcancavel[i + 1] ? *peso : pesoAlcancavel[i + 1];
+            int v = *volume < volumeAlcancavel[i + 1] ? *volume : volumeAlcancavel[i + 1];
+            if ((decisoes[(size_t)p * (volumeMax + 1) + v] >> (i - inicio)) & 1) {
+                escolhidos[i] = 1;
+                *peso   -= itens[i].peso;
+                *volume -= itens[i].volume;
+            }
+        }
+        free(decisoes);
+        free(camada);
+    } else {
+        int meio = inicio + (fim - inicio) / 2;
+        int32_t *camadaMeio = copiarCamada(base, pesoMax, volumeMax, passo);
+        avancarCamada(camadaMeio, pesoMax, volumeMax, volumeMax + 1, itens, inicio, meio, pesoAlcancavel,
+                      volumeAlcancavel, NULL);
+        reconstruirIntervalo(camadaMeio, volumeMax + 1, itens, meio, fim, pesoAlcancavel, volumeAlcancavel, peso,
+                             volume, escolhidos);
+        free(camadaMeio);
+        reconstruirIntervalo(base, passo, itens, inicio, meio, pesoAlcancavel, volumeAlcancavel, peso, volume,
+                             escolhidos);
+    }
 
-    // Reconstrução da solução ótima (backtracking)
+    *peso += sobraPeso;
+    *volume += sobraVolume;
+}
+
+// Mesmo resultado de resolverMochilaPorCamadas, guardando só camadas DP
+void resolverMochilaPorDivisao(const ItemMochila *itens, int quantidadeItens, int capacidadePesoMaxima, int capacidadeVolumeMaxima, char *escolhidos) {
     int pesoRestante = capacidadePesoMaxima;
     int volRestante  = capacidadeVolumeMaxima;
-    Pacote **vetorPacotesEscolhidos = malloc(quantidadePacotesDisponiveis * sizeof(Pacote *));
-    if (vetorPacotesEscolhidos == NULL) {
-        perror("Erro na alocacao do vetor de pacotes escolhidos");
+    int32_t *camadaZero = calloc((size_t)(pesoRestante + 1) * (volRestante + 1), sizeof(int32_t));
+    int *pesoAlcancavel = malloc((quantidadeItens + 1) * sizeof(int));
+    int *volumeAlcancavel = malloc((quantidadeItens + 1) * sizeof(int));
+    if (camadaZero == NULL || pesoAlcancavel == NULL || volumeAlcancavel == NULL) {
+        perror("Erro na alocacao da reconstrucao por divisao");
         exit(EXIT_FAILURE);
     }
-    int contador = 0;
+    calcularAlcancaveis(itens, quantidadeItens, capacidadePesoMaxima, capacidadeVolumeMaxima,
+                        pesoAlcancavel, volumeAlcancavel);
+
+    reconstruirIntervalo(camadaZero, volRestante + 1, itens, 0, quantidadeItens, pesoAlcancavel, volumeAlcancavel,
+                         &pesoRestante, &volRestante, escolhidos);
+    free(camadaZero);
+    free(pesoAlcancavel);
+    free(volumeAlcancavel);
+}
+
+
+//--------------[ Branch-and-bound para capacidades grandes (opção -ramificacao) ]----------------
 
-    // Percorre as camadas de trás para frente para identificar os itens incluídos
-    for (int i = quantidadePacotesDisponiveis; i >= 1; i--) {
-        if (valorAbsoluto(DP(i, pesoRestante, volRestante) - DP(i - 1, pesoRestante, volRestante)) > TOLERANCIA) {
-            vetorPacotesEscolhidos[contador++] = vetorPacotesAux[i];
-            pesoRestante -= vetorPacotesAux[i]->peso;
-            volRestante  -= vetorPacotesAux[i]->volume;
+/*
+   Quando nem uma camada DP cabe em LIMITE_BYTES_CAMADA, a mochila é resolvida
+   por busca em profundidade com poda, sem tabela. Quando a camada cabe mas a
+   DP faria mais de LIMITE_ATUALIZACOES_DP atualizações de estado (itens x W·V
+   alcançável), a busca é tentada antes com um orçamento de nós proporcional à
+   camada; se ele acabar, o veículo volta para a DP.
+     - na raiz, os multiplicadores (u, w) da relaxação lagrangiana das duas
+       restrições são ajustados por busca ternária; a restrição substituta
+       u·peso + w·volume <= u·W + w·V junta peso e volume numa só medida;
+     - o limite superior de um nó é o menor entre as relaxações lineares
+       (mochila fracionária) no peso, no volume e na restrição substituta,
+       percorrendo os itens livres em ordem decrescente de densidade
+       (centavos por unidade da medida); itens que não cabem sozinhos ficam
+       de fora;
+     - itens cujo custo reduzido já deixa o limite da raiz abaixo do ótimo
+       não estão em nenhuma carga ótima e são fixados fora;
+     - a primeira busca ramifica em ordem de densidade substituta, incluindo
+       primeiro, e acha o valor ótimo;
+     - a segunda busca ramifica do último item ao primeiro, excluindo
+       primeiro, e para na primeira carga que atinge o ótimo. É a mesma carga
+       da reconstrução da DP, que só inclui o item i quando não há como
+       atingir o ótimo restante sem ele.
+   O tempo depende da instância (exponencial no pior caso, daí o orçamento),
+   mas não de W·V.
+*/
+
+typedef struct BuscaMochila {
+    const ItemMochila *itens;
+    int quantidadeItens;
+    double *medidas[3];         // Peso, volume e medida substituta de cada item
+    int *ordens[3];             // Índices em ordem decrescente de centavos por unidade de cada medida
+    double multiplicadorPeso;
+    double multiplicadorVolume;
+    char *decidido;             // 1 para os itens fixados no caminho atual (ou fora de qualquer carga ótima)
+    long long melhorValor;      // Primeira busca: melhor valor encontrado
+    char *escolhidos;           // Segunda busca: itens incluídos no caminho atual
+    long long nos;              // Nós visitados nas duas buscas
+    long long limiteNos;        // Orçamento de nós (-1: sem limite)
+    int interrompida;           // 1 quando o orçamento acabou
+} BuscaMochila;
+
+// Conta um nó; retorna 0 (e marca a busca como interrompida) quando o orçamento acabou
+static int visitarNo(BuscaMochila *busca) {
+    if (busca->interrompida) return 0;
+    if (busca->limiteNos >= 0 && ++busca->nos > busca->limiteNos) {
+        busca->interrompida = 1;
+        return 0;
+    }
+    return 1;
+}
+
+static const ItemMochila *itensOrdenacao;  // Itens e medida comparados por compararDensidade (qsort)
+static const double *medidasOrdenacao;
+
+static int compararDensidade(const void *a, const void *b) {
+    int i = *(const int *)a, j = *(const int *)b;
+    // Itens sem valor positivo (ignorados pelos limites) vão para o fim; sem isso, 0/0 empataria com tudo
+    int positivoI = itensOrdenacao[i].centavos > 0, positivoJ = itensOrdenacao[j].centavos > 0;
+    if (positivoI != positivoJ) return positivoI ? -1 : 1;
+    // centavosI / medidaI > centavosJ / medidaJ, sem divisão (medida 0 conta como densidade infinita)
+    double esquerda = itensOrdenacao[i].centavos * medidasOrdenacao[j];
+    double direita = itensOrdenacao[j].centavos * medidasOrdenacao[i];
+    if (esquerda != direita) return esquerda > direita ? -1 : 1;
+    return i - j;
+}
+
+// Relaxação linear na medida 'm' (0: peso, 1: volume, 2: substituta) sobre os itens livres e com valor positivo
+static double limiteFracionario(const BuscaMochila *busca, int m, int pesoLivre, int volumeLivre) {
+    double capacidade = m == 0 ? pesoLivre
+                      : m == 1 ? volumeLivre
+                      : busca->multiplicadorPeso * pesoLivre + busca->multiplicadorVolume * volumeLivre;
+    double limite = 0.0;
+    for (int k = 0; k < busca->quantidadeItens; k++) {
+        int i = busca->ordens[m][k];
+        const ItemMochila *item = &busca->itens[i];
+        if (item->centavos <= 0) break;  // Daqui em diante, só itens sem valor
+        if (busca->decidido[i] || item->peso > pesoLivre || item->volume > volumeLivre) continue;
+        double medida = busca->medidas[m][i];
+        if (medida <= capacidade) {
+            limite += item->centavos;
+            capacidade -= medida;
+        } else {
+            limite += item->centavos * capacidade / medida;
+            break;
         }
     }
+    return limite;
+}
 
-    // Inverte a ordem dos itens para manter a sequência original
-    for (int i = 0; i < contador / 2; i++) {
-        Pacote *temp = vetorPacotesEscolhidos[i];
-        vetorPacotesEscolhidos[i] = vetorPacotesEscolhidos[contador - 1 - i];
-        vetorPacotesEscolhidos[contador - 1 - i] = temp;
+static double limiteSuperior(const BuscaMochila *busca, int pesoLivre, int volumeLivre) {
+    double limite = limiteFracionario(busca, 2, pesoLivre, volumeLivre);
+    for (int m = 0; m < 2; m++) {
+        double outro = limiteFracionario(busca, m, pesoLivre, volumeLivre);
+        if (outro < limite) limite = outro;
     }
+    return limite;
+}
 
-    free(tabelaDP);
-    free(vetorPacotesAux);
+// Relaxação lagrangiana: u·W + w·V + soma dos custos reduzidos positivos (limite superior para quaisquer u, w >= 0)
+static double valorLagrangiano(const BuscaMochila *busca, double u, double w, int pesoMax, int volumeMax) {
+    double valor = u * pesoMax + w * volumeMax;
+    for (int i = 0; i < busca->quantidadeItens; i++) {
+        const ItemMochila *item = &busca->itens[i];
+        double reduzido = item->centavos - u * item->peso - w * item->volume;
+        if (reduzido > 0 && item->peso <= pesoMax && item->volume <= volumeMax) valor += reduzido;
+    }
+    return valor;
+}
 
-    *quantidadePacotesEscolhidos = contador;
-    return vetorPacotesEscolhidos;
+// Melhor u para um w fixo (a função é convexa em u)
+static double ajustarMultiplicadorPeso(const BuscaMochila *busca, double w, double maximo, int pesoMax, int volumeMax,
+                                       double *valor) {
+    double inicio = 0.0, fim = maximo;
+    for (int passo = 0; passo < PASSOS_BUSCA_MULTIPLICADOR; passo++) {
+        double a = inicio + (fim - inicio) / 3, b = fim - (fim - inicio) / 3;
+        if (valorLagrangiano(busca, a, w, pesoMax, volumeMax) <= valorLagrangiano(busca, b, w, pesoMax, volumeMax)) {
+            fim = b;
+        } else {
+            inicio = a;
+        }
+    }
+    double u = (inicio + fim) / 2;
+    *valor = valorLagrangiano(busca, u, w, pesoMax, volumeMax);
+    return u;
+}
+
+// Ajusta os multiplicadores (mínimo do dual lagrangiano) e ordena os itens pela densidade substituta
+static void prepararMultiplicadores(BuscaMochila *busca, int pesoMax, int volumeMax) {
+    double maximoPeso = 0.0, maximoVolume = 0.0;  // Acima disso, todo custo reduzido é negativo
+    for (int i = 0; i < busca->quantidadeItens; i++) {
+        const ItemMochila *item = &busca->itens[i];
+        if (item->centavos <= 0) continue;
+        if (item->peso > 0 && (double)item->centavos / item->peso > maximoPeso) {
+            maximoPeso = (double)item->centavos / item->peso;
+        }
+        if (item->volume > 0 && (double)item->centavos / item->volume > maximoVolume) {
+            maximoVolume = (double)item->centavos / item->volume;
+        }
+    }
+
+    double inicio = 0.0, fim = maximoVolume, valorA, valorB;
+    for (int passo = 0; passo < PASSOS_BUSCA_MULTIPLICADOR; passo++) {
+        double a = inicio + (fim - inicio) / 3, b = fim - (fim - inicio) / 3;
+        ajustarMultiplicadorPeso(busca, a, maximoPeso, pesoMax, volumeMax, &valorA);
+        ajustarMultiplicadorPeso(busca, b, maximoPeso, pesoMax, volumeMax, &valorB);
+        if (valorA <= valorB) {
+            fim = b;
+        } else {
+            inicio = a;
+        }
+    }
+    busca->multiplicadorVolume = (inicio + fim) / 2;
+    busca->multiplicadorPeso = ajustarMultiplicadorPeso(busca, busca->multiplicadorVolume, maximoPeso, pesoMax,
+                                                        volumeMax, &valorA);
+
+    for (int i = 0; i < busca->quantidadeItens; i++) {
+        busca->medidas[2][i] = busca->multiplicadorPeso * busca->itens[i].peso +
+                               busca->multiplicadorVolume * busca->itens[i].volume;
+    }
+}
+
+// Fixa fora os itens que, incluídos, deixam o limite lagrangiano da raiz abaixo de 'valorMinimo'
+static void fixarPorCustoReduzido(BuscaMochila *busca, int pesoMax, int volumeMax, long long valorMinimo) {
+    double u = busca->multiplicadorPeso, w = busca->multiplicadorVolume;
+    double limite = valorLagrangiano(busca, u, w, pesoMax, volumeMax);
+    for (int i = 0; i < busca->quantidadeItens; i++) {
+        const ItemMochila *item = &busca->itens[i];
+        double reduzido = item->centavos - u * item->peso - w * item->volume;
+        if (reduzido < 0 && limite + reduzido < valorMinimo - 0.5) busca->decidido[i] = 1;
+    }
+}
 
-    #undef DP
+// Carga gulosa na ordem substituta: valor inicial para a poda
+static long long valorGuloso(const BuscaMochila *busca, int pesoLivre, int volumeLivre) {
+    long long valor = 0;
+    for (int k = 0; k < busca->quantidadeItens; k++) {
+        const ItemMochila *item = &busca->itens[busca->ordens[2][k]];
+        if (item->centavos <= 0) break;
+        if (item->peso <= pesoLivre && item->volume <= volumeLivre) {
+            valor += item->centavos;
+            pesoLivre -= item->peso;
+            volumeLivre -= item->volume;
+        }
+    }
+    return valor;
+}
+
+// Primeira busca: melhor valor, ramificando na ordem de densidade substituta (incluir primeiro)
+static void buscarMelhorValor(BuscaMochila *busca, int profundidade, int pesoLivre, int volumeLivre, long long valor) {
+    if (!visitarNo(busca)) return;
+    if (valor > busca->melhorValor) busca->melhorValor = valor;
+    // Itens fixados fora não ramificam; itens sem valor (no fim da ordem) nunca melhoram a carga
+    while (profundidade < busca->quantidadeItens && busca->decidido[busca->ordens[2][profundidade]]) profundidade++;
+    if (profundidade == busca->quantidadeItens || busca->itens[busca->ordens[2][profundidade]].centavos <= 0) return;
+    // Valores são inteiros: o ramo só interessa se puder passar o melhor em pelo menos um centavo
+    if (valor + limiteSuperior(busca, pesoLivre, volumeLivre) < busca->melhorValor + 0.5) return;
+
+    int i = busca->ordens[2][profundidade];
+    const ItemMochila *item = &busca->itens[i];
+    busca->decidido[i] = 1;
+    if (item->peso <= pesoLivre && item->volume <= volumeLivre) {
+        buscarMelhorValor(busca, profundidade + 1, pesoLivre - item->peso, volumeLivre - item->volume,
+                          valor + item->centavos);
+    }
+    buscarMelhorValor(busca, profundidade + 1, pesoLivre, volumeLivre, valor);
+    busca->decidido[i] = 0;
+}
+
+// Segunda busca: do item i ao 0, excluindo primeiro; retorna 1 ao atingir 'faltando' (a carga fica em escolhidos)
+static int buscarCargaDesempatada(BuscaMochila *busca, int i, int pesoLivre, int volumeLivre, long long faltando) {
+    if (faltando <= 0) return 1;
+    if (!visitarNo(busca)) return 0;
+    while (i >= 0 && busca->decidido[i]) i--;  // Fixados fora
+    if (i < 0 || limiteSuperior(busca, pesoLivre, volumeLivre) < faltando - 0.5) return 0;
+
+    const ItemMochila *item = &busca->itens[i];
+    busca->decidido[i] = 1;
+    if (buscarCargaDesempatada(busca, i - 1, pesoLivre, volumeLivre, faltando)) return 1;
+    if (item->peso <= pesoLivre && item->volume <= volumeLivre) {
+        busca->escolhidos[i] = 1;
+        if (buscarCargaDesempatada(busca, i - 1, pesoLivre - item->peso, volumeLivre - item->volume,
+                                   faltando - item->centavos)) {
+            return 1;
+        }
+        busca->escolhidos[i] = 0;
+    }
+    busca->decidido[i] = 0;
+    return 0;
+}
+
+// Mesmo resultado de resolverMochilaPorCamadas, sem tabela DP. Retorna 0 (sem nada marcado em 'escolhidos')
+// se as buscas passarem de 'limiteNos' nós (-1: sem limite).
+int resolverMochilaPorRamificacao(const ItemMochila *itens, int quantidadeItens, int capacidadePesoMaxima, int capacidadeVolumeMaxima, long long limiteNos, char *escolhidos) {
+    BuscaMochila busca;
+    busca.nos = 0;
+    busca.limiteNos = limiteNos;
+    busca.interrompida = 0;
+    busca.itens = itens;
+    busca.quantidadeItens = quantidadeItens;
+    busca.decidido = calloc(quantidadeItens, sizeof(char));
+    busca.melhorValor = 0;
+    busca.escolhidos = escolhidos;
+    int alocado = busca.decidido != NULL;
+    for (int m = 0; m < 3; m++) {
+        busca.medidas[m] = malloc(quantidadeItens * sizeof(double));
+        busca.ordens[m] = malloc(quantidadeItens * sizeof(int));
+        alocado = alocado && busca.medidas[m] != NULL && busca.ordens[m] != NULL;
+    }
+    if (!alocado) {
+        perror("Erro na alocacao do branch-and-bound");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < quantidadeItens; i++) {
+        busca.medidas[0][i] = itens[i].peso;
+        busca.medidas[1][i] = itens[i].volume;
+    }
+    prepararMultiplicadores(&busca, capacidadePesoMaxima, capacidadeVolumeMaxima);
+
+    itensOrdenacao = itens;
+    for (int m = 0; m < 3; m++) {
+        for (int i = 0; i < quantidadeItens; i++) {
+            busca.ordens[m][i] = i;
+        }
+        medidasOrdenacao = busca.medidas[m];
+        qsort(busca.ordens[m], quantidadeItens, sizeof(int), compararDensidade);
+    }
+
+    busca.melhorValor = valorGuloso(&busca, capacidadePesoMaxima, capacidadeVolumeMaxima);
+    fixarPorCustoReduzido(&busca, capacidadePesoMaxima, capacidadeVolumeMaxima, busca.melhorValor);
+    buscarMelhorValor(&busca, 0, capacidadePesoMaxima, capacidadeVolumeMaxima, 0);
+    fixarPorCustoReduzido(&busca, capacidadePesoMaxima, capacidadeVolumeMaxima, busca.melhorValor);
+    if (!busca.interrompida) {
+        buscarCargaDesempatada(&busca, quantidadeItens - 1, capacidadePesoMaxima, capacidadeVolumeMaxima,
+                               busca.melhorValor);
+    }
+    if (busca.interrompida) memset(escolhidos, 0, quantidadeItens * sizeof(char));
+
+    for (int m = 0; m < 3; m++) {
+        free(busca.medidas[m]);
+        free(busca.ordens[m]);
+    }
+    free(busca.decidido);
+    return !busca.interrompida;
 }
 
 
@@ -208,11 +1104,13 @@ void liberarMemoria(Veiculo *vetorVeiculos, Pacote *todosPacotes, int numeroVeic
 void processarArquivo(char *entrada, char *saida){
 
     FILE *arquivoEntrada = fopen(entrada, "r");
-    FILE *arquivoSaida   = fopen(saida, "w");
-    if (arquivoEntrada == NULL || arquivoSaida == NULL) {
+    EscritorRapido escritorSaida;
+    int saidaAberta = abrirEscritor(&escritorSaida, saida);
+    EscritorRapido *arquivoSaida = &escritorSaida;
+    if (arquivoEntrada == NULL || !saidaAberta) {
         fprintf(stderr, "Erro ao abrir os arquivos.\n");
         if (arquivoEntrada) fclose(arquivoEntrada);
-        if (arquivoSaida) fclose(arquivoSaida);
+        if (saidaAberta) fecharEscritor(arquivoSaida);
         return;
     }
 
@@ -248,6 +1146,7 @@ void processarArquivo(char *entrada, char *saida){
         fscanf(arquivoEntrada, "%s %f %d %d", 
                todosPacotes[i].codigo, &todosPacotes[i].valor,
                &todosPacotes[i].peso, &todosPacotes[i].volume);
+        todosPacotes[i].centavos = arredondarLongo((double)todosPacotes[i].valor * 100);
         todosPacotes[i].ordem = i;       // Define a ordem de chegada
         todosPacotes[i].disponivel = 1;    // Inicialmente, todos estão disponíveis
     }
@@ -302,21 +1201,27 @@ void processarArquivo(char *entrada, char *saida){
                              arredondar((double)vetorVeiculos[i].pesoAtual * 100 / vetorVeiculos[i].pesoLimite) : 0;
         int percentualVolume = (vetorVeiculos[i].volumeLimite > 0) ?
                                arredondar((double)vetorVeiculos[i].volumeAtual * 100 / vetorVeiculos[i].volumeLimite) : 0;
-        fprintf(arquivoSaida, "[%s]R$%.2f,%dKG(%d%%),%dL(%d%%)->",
-                vetorVeiculos[i].placa,
-                vetorVeiculos[i].valorTransportado,
-                vetorVeiculos[i].pesoAtual, percentualPeso,
-                vetorVeiculos[i].volumeAtual, percentualVolume);
+        escreverCaractere(arquivoSaida, '[');
+        escreverTexto(arquivoSaida, vetorVeiculos[i].placa);
+        escreverFormatado(arquivoSaida, "]R$%.2f,", vetorVeiculos[i].valorTransportado);
+        escreverInteiro(arquivoSaida, vetorVeiculos[i].pesoAtual);
+        escreverTexto(arquivoSaida, "KG(");
+        escreverInteiro(arquivoSaida, percentualPeso);
+        escreverTexto(arquivoSaida, "%),");
+        escreverInteiro(arquivoSaida, vetorVeiculos[i].volumeAtual);
+        escreverTexto(arquivoSaida, "L(");
+        escreverInteiro(arquivoSaida, percentualVolume);
+        escreverTexto(arquivoSaida, "%)->");
         if (vetorVeiculos[i].quantidadeCargas == 0)
-            fprintf(arquivoSaida, "Nenhum pacote carregado");
+            escreverTexto(arquivoSaida, "Nenhum pacote carregado");
         else {
             for (int j = 0; j < vetorVeiculos[i].quantidadeCargas; j++) {
                 if (j > 0)
-                    fprintf(arquivoSaida, ",");
-                fprintf(arquivoSaida, "%s", vetorVeiculos[i].codigos[j]);
+                    escreverCaractere(arquivoSaida, ',');
+                escreverTexto(arquivoSaida, vetorVeiculos[i].codigos[j]);
             }
         }
-        fprintf(arquivoSaida, "\n");
+        escreverCaractere(arquivoSaida, '\n');
     }
 
     // Imprime os pacotes pendentes (aqueles que ainda estão disponíveis) e a soma total de seus atributos
@@ -330,24 +1235,28 @@ void processarArquivo(char *entrada, char *saida){
             somaVolumePendentes += todosPacotes[i].volume;
         }
     }
-    fprintf(arquivoSaida, "PENDENTE:R$%.2f,%dKG,%dL->", somaValorPendentes, somaPesoPendentes, somaVolumePendentes);
+    escreverFormatado(arquivoSaida, "PENDENTE:R$%.2f,", somaValorPendentes);
+    escreverInteiro(arquivoSaida, somaPesoPendentes);
+    escreverTexto(arquivoSaida, "KG,");
+    escreverInteiro(arquivoSaida, somaVolumePendentes);
+    escreverTexto(arquivoSaida, "L->");
     int pendentesImpressos = 0;
     for (int i = 0; i < quantidadeTotalPacotes; i++) {
         if (todosPacotes[i].disponivel == 1) {
             if (pendentesImpressos > 0)
-                fprintf(arquivoSaida, ",");
-            fprintf(arquivoSaida, "%s", todosPacotes[i].codigo);
+                escreverCaractere(arquivoSaida, ',');
+            escreverTexto(arquivoSaida, todosPacotes[i].codigo);
             pendentesImpressos++;
         }
     }
     if (pendentesImpressos == 0)
-        fprintf(arquivoSaida, "Nenhum pacote pendente");
-    fprintf(arquivoSaida, "\n");
+        escreverTexto(arquivoSaida, "Nenhum pacote pendente");
+    escreverCaractere(arquivoSaida, '\n');
 
     // Libera a memória alocada para os veículos
     liberarMemoria(vetorVeiculos, todosPacotes, numeroVeiculos, quantidadeTotalPacotes);
 
     fclose(arquivoEntrada);
-    fclose(arquivoSaida);
+    fecharEscritor(arquivoSaida);
 
 }
@@ -1,6 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include "../comum/quickSortGenerico.h" // QuickSort por pares (chave, índice)
+#include "../comum/escritorRapido.h" // Saída com buffer (um write por descarga)
 
 #define TAMANHO_CODIGO 10 // Tamanho máximo do código de identificação da doença
 
@@ -16,58 +19,29 @@ typedef struct {
 static const char *cadeiaGenesGlobal;    // Cadeia principal de genes
 static int tamanhoSubcadeiaGlobal;       // Comprimento alvo das subcadeias
 
-// Função de comparação para ordenar índices de subcadeias
-int compararSubcadeias(const void *a, const void *b) {
-    int indiceA = *(const int*)a;
-    int indiceB = *(const int*)b;
-    return strncmp(cadeiaGenesGlobal + indiceA, 
-                   cadeiaGenesGlobal + indiceB, 
-                   tamanhoSubcadeiaGlobal);
+/**
+ * Chave de ordenação de uma subcadeia: seus oito primeiros caracteres
+ * @param registro Ponteiro para o índice inicial da subcadeia
+ * @return Prefixo em big-endian (mesma ordem do strncmp)
+ */
+uint64_t chaveSubcadeia(const void *registro) {
+    int indice = *(const int*)registro;
+    return chaveDePrefixo(cadeiaGenesGlobal + indice, tamanhoSubcadeiaGlobal);
 }
 
 /**
- * Implementação customizada do algoritmo QuickSort para manter a estabilidade
- * @param base Ponteiro para o array a ser ordenado
- * @param numElementos Número de elementos no array
- * @param tamanhoElemento Tamanho de cada elemento em bytes
- * @param comparar Função de comparação personalizada
+ * Desempate de subcadeias com o mesmo prefixo: compara o restante dos caracteres
+ * @param posicaoA Posição da primeira subcadeia no vetor de índices
+ * @param posicaoB Posição da segunda subcadeia no vetor de índices
+ * @param contexto Vetor de índices das subcadeias
+ * @return Resultado do strncmp do restante das subcadeias
  */
-void quickSortCustomizado(void *base, size_t numElementos, size_t tamanhoElemento, 
-                         int (*comparar)(const void *, const void *)) {
-    if (numElementos <= 1) return;
-
-    char *array = (char *)base;
-    size_t indicePivo = numElementos - 1;
-    char *pivo = array + indicePivo * tamanhoElemento;
-
-    size_t indiceParticao = 0; // Índice de partição
-
-    for (size_t j = 0; j < numElementos - 1; j++) {
-        char *atual = array + j * tamanhoElemento;
-        if (comparar(atual, pivo) <= 0) {
-            if (indiceParticao != j) {
-                // Troca elementos usando memcpy para tipos genéricos
-                char temp[tamanhoElemento];
-                memcpy(temp, array + indiceParticao * tamanhoElemento, tamanhoElemento);
-                memcpy(array + indiceParticao * tamanhoElemento, atual, tamanhoElemento);
-                memcpy(atual, temp, tamanhoElemento);
-            }
-            indiceParticao++;
-        }
-    }
-
-    // Coloca o pivô na posição correta
-    if (indiceParticao != indicePivo) {
-        char temp[tamanhoElemento];
-        memcpy(temp, array + indiceParticao * tamanhoElemento, tamanhoElemento);
-        memcpy(array + indiceParticao * tamanhoElemento, pivo, tamanhoElemento);
-        memcpy(pivo, temp, tamanhoElemento);
-    }
-
-    // Chamadas recursivas para as partições
-    quickSortCustomizado(array, indiceParticao, tamanhoElemento, comparar);
-    quickSortCustomizado(array + (indiceParticao + 1) * tamanhoElemento, 
-                       numElementos - indiceParticao - 1, tamanhoElemento, comparar);
+int desempatarSubcadeias(int posicaoA, int posicaoB, void *contexto) {
+    const int *indices = (const int*)contexto;
+    if (tamanhoSubcadeiaGlobal <= 8) return 0;
+    return strncmp(cadeiaGenesGlobal + indices[posicaoA] + 8,
+                   cadeiaGenesGlobal + indices[posicaoB] + 8,
+                   tamanhoSubcadeiaGlobal - 8);
 }
 
 /**
@@ -202,10 +176,10 @@ void mergeSort(Doenca *doencas, int esquerda, int direita) {
  * @param numDoencas Número de doenças
  * @param arquivoSaida Arquivo de saída
  */
-void imprimirDoencas(Doenca *doencas, int numDoencas, FILE *arquivoSaida) {
+void imprimirDoencas(Doenca *doencas, int numDoencas, EscritorRapido *arquivoSaida) {
     for (int i = 0; i < numDoencas; i++) {
-        fprintf(arquivoSaida, "%s->%.0f%%\n", 
-               doencas[i].codigo, doencas[i].probabilidade);
+        escreverTexto(arquivoSaida, doencas[i].codigo);
+        escreverFormatado(arquivoSaida, "->%.0f%%\n", doencas[i].probabilidade);
     }
 }
 
@@ -216,9 +190,11 @@ void imprimirDoencas(Doenca *doencas, int numDoencas, FILE *arquivoSaida) {
  */
 void processarArquivo(const char *arquivoEntrada, const char *arquivoSaida) {
     FILE *entrada = fopen(arquivoEntrada, "r");
-    FILE *saida = fopen(arquivoSaida, "w");
+    EscritorRapido escritorSaida;
+    int saidaAberta = abrirEscritor(&escritorSaida, arquivoSaida);
+    EscritorRapido *saida = &escritorSaida;
 
-    if (!entrada || !saida) {
+    if (!entrada || !saidaAberta) {
         printf("Erro ao abrir arquivos\n");
         return;
     }
@@ -238,12 +214,26 @@ void processarArquivo(const char *arquivoEntrada, const char *arquivoSaida) {
     int *indices = NULL;
     if (numSubcadeias > 0) {
         indices = malloc(numSubcadeias * sizeof(int));
+        if (indices == NULL) {
+            perror("Erro ao alocar os indices das subcadeias");
+            exit(EXIT_FAILURE);
+        }
         for (int i = 0; i < numSubcadeias; i++) indices[i] = i;
         
         // Configura globais para uso na comparação
         cadeiaGenesGlobal = cadeiaGenes;
         tamanhoSubcadeiaGlobal = tamanhoSubcadeia;
-        quickSortCustomizado(indices, numSubcadeias, sizeof(int), compararSubcadeias);
+
+        // Ordena pares (prefixo, índice); as subcadeias nunca são movidas durante o particionamento.
+        // Como indices[i] == i, a permutação resultante já é o vetor de índices ordenado.
+        int *ordem = malloc(numSubcadeias * sizeof(int));
+        if (ordem == NULL || !ordenarIndicesPorChaveComDesempate(indices, numSubcadeias, sizeof(int), chaveSubcadeia,
+                                                                 desempatarSubcadeias, indices, ordem)) {
+            perror("Erro ao ordenar as subcadeias");
+            exit(EXIT_FAILURE);
+        }
+        free(indices);
+        indices = ordem;
     }
 
     // Lê número de doenças
@@ -337,7 +327,7 @@ void processarArquivo(const char *arquivoEntrada, const char *arquivoSaida) {
     free(doencas);
     
     fclose(entrada);
-    fclose(saida);
+    fecharEscritor(saida);
 }
 
 int main(int argc, char **argv) {
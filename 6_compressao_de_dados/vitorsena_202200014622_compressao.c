@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include "../comum/heapDario.h"  // Heap d-ário iterativo compartilhado
 
 // Tabela de lookup para conversão de hexadecimal (apenas caracteres válidos)
 static const unsigned char hexLookup[128] = {
@@ -19,12 +20,12 @@ typedef struct No {
     struct No *esq, *dir;
 } No;
 
-// Estrutura para o min-heap
-typedef struct {
-    No **array;     // Array de ponteiros para nós
-    int tamanho;    // Número atual de nós
-    int capacidade; // Capacidade máxima do heap
-} MinHeap;
+// Min-heap de ponteiros para nós, ordenado pela frequência.
+// Binário: a ordem de retirada dos empates define os códigos gerados, então
+// ARIDADE 2 mantém exatamente as mesmas árvores (e saídas) de antes.
+#define ARIDADE_HEAP_HUFFMAN 2
+#define MENOR_FREQUENCIA(a, b) ((a)->freq < (b)->freq)
+DEFINIR_HEAP_DARIO(MinHeap, No *, ARIDADE_HEAP_HUFFMAN, MENOR_FREQUENCIA)
 
 // Estrutura para a pilha usada na geração iterativa dos códigos de Huffman
 typedef struct {
@@ -41,11 +42,6 @@ void processarArquivo(const char *arquivoEntrada, const char *arquivoSaida);
 static unsigned char *hexParaBytes(const char *sequenciaHex, int qtdBytes);
 static void zerarFrequencias(void);
 static int *contarFrequencia(const unsigned char *dados, int n);
-static MinHeap *criarMinHeap(int capacidade);
-static void inserirMinHeap(MinHeap *heap, No *novoNo);
-static No *extrairMin(MinHeap *heap);
-static void troca(No **a, No **b);
-static void heapify(MinHeap *heap, int idx);
 static No *construirArvoreHuffman(const int *frequencia);
 static void gerarCodigosHuffmanIterativo(No *raiz, char codigos[256][256]);
 static void liberarArvore(No *raiz);
@@ -164,59 +160,6 @@ static int *contarFrequencia(const unsigned char *dados, int n) {
     return freqBuffer;
 }
 
-//----------------[ Cria min-heap ]----------------
-static MinHeap *criarMinHeap(int capacidade) {
-    MinHeap *heap = malloc(sizeof(MinHeap));
-    heap->array = malloc(capacidade * sizeof(No*));
-    heap->tamanho = 0;
-    heap->capacidade = capacidade;
-    return heap;
-}
-
-//----------------[ Insere nó no min-heap ]----------------
-static void inserirMinHeap(MinHeap *heap, No *novoNo) {
-    if (heap->tamanho >= heap->capacidade) return;
-    heap->array[heap->tamanho] = novoNo;
-    int i = heap->tamanho;
-    heap->tamanho++;
-    while (i && heap->array[i]->freq < heap->array[(i - 1) / 2]->freq) {
-        troca(&heap->array[i], &heap->array[(i - 1) / 2]);
-        i = (i - 1) / 2;
-    }
-}
-
-//----------------[ Extrai o menor nó do heap ]----------------
-static No *extrairMin(MinHeap *heap) {
-    if (!heap->tamanho) return NULL;
-    No *temp = heap->array[0];
-    heap->tamanho--;
-    heap->array[0] = heap->array[heap->tamanho];
-    heapify(heap, 0);
-    return temp;
-}
-
-//----------------[ Troca ponteiros de nós ]----------------
-static void troca(No **a, No **b) {
-    No *t = *a;
-    *a = *b;
-    *b = t;
-}
-
-//----------------[ Mantém propriedade do min-heap ]----------------
-static void heapify(MinHeap *heap, int idx) {
-    int menor = idx;
-    int esq = 2 * idx + 1;
-    int dir = 2 * idx + 2;
-    if (esq < heap->tamanho && heap->array[esq]->freq < heap->array[menor]->freq)
-        menor = esq;
-    if (dir < heap->tamanho && heap->array[dir]->freq < heap->array[menor]->freq)
-        menor = dir;
-    if (menor != idx) {
-        troca(&heap->array[menor], &heap->array[idx]);
-        heapify(heap, menor);
-    }
-}
-
 //----------------[ Constrói árvore de Huffman a partir das frequências ]----------------
 static No *construirArvoreHuffman(const int *frequencia) {
     int count = 0;
@@ -227,31 +170,32 @@ static No *construirArvoreHuffman(const int *frequencia) {
     if (count == 0)
         return NULL;
 
-    MinHeap *heap = criarMinHeap(count);
+    MinHeap heap;
+    if (!iniciarMinHeap(&heap, count))
+        return NULL;
     for (int i = 0; i < 256; i++) {
         if (frequencia[i] > 0) {
             No *novo = malloc(sizeof(No));
             novo->simbolo = (unsigned char)i;
             novo->freq = frequencia[i];
             novo->esq = novo->dir = NULL;
-            inserirMinHeap(heap, novo);
+            inserirMinHeap(&heap, novo);
         }
     }
 
-    while (heap->tamanho > 1) {
-        No *min1 = extrairMin(heap);
-        No *min2 = extrairMin(heap);
+    while (heap.tamanho > 1) {
+        No *min1 = removerMinimoMinHeap(&heap);
+        No *min2 = removerMinimoMinHeap(&heap);
         No *interno = malloc(sizeof(No));
         interno->simbolo = 0;
         interno->freq = min1->freq + min2->freq;
         interno->esq = min1;
         interno->dir = min2;
-        inserirMinHeap(heap, interno);
+        inserirMinHeap(&heap, interno);
     }
 
-    No *raiz = extrairMin(heap);
-    free(heap->array);
-    free(heap);
+    No *raiz = removerMinimoMinHeap(&heap);
+    liberarMinHeap(&heap);
     return raiz;
 }
 
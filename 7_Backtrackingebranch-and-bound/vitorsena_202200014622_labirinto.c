@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "../comum/escritorRapido.h" // Saída com buffer e conversão manual de inteiros
 
 #define MAX_SIZE 100
 
@@ -10,9 +11,12 @@ typedef struct {
 } Posicao;
 
 bool isSaida(Posicao pos, int linhas, int colunas, Posicao inicio, char labirinto[][MAX_SIZE]);
+void escreverPosicao(EscritorRapido *output, Posicao pos);
+void escreverMovimento(EscritorRapido *output, const char *dir, Posicao prox);
+void escreverRetrocesso(EscritorRapido *output, Posicao de, Posicao para);
 bool encontrarSaida(char labirinto[][MAX_SIZE], bool visitados[][MAX_SIZE], bool dead[][MAX_SIZE],
                    int linhas, int colunas, Posicao atual, Posicao inicio, 
-                   FILE *output, Posicao *saida);
+                   EscritorRapido *output, Posicao *saida);
 
 int main(int argc, char *argv[]) {
     if(argc < 3) {
@@ -21,12 +25,14 @@ int main(int argc, char *argv[]) {
     }
 
     FILE *input = fopen(argv[1], "r");
-    FILE *output = fopen(argv[2], "w");
+    EscritorRapido escritorSaida;
+    int saidaAberta = abrirEscritor(&escritorSaida, argv[2]);
+    EscritorRapido *output = &escritorSaida;
     
-    if(!input || !output) {
+    if(!input || !saidaAberta) {
         fprintf(stderr, "Erro ao abrir arquivos.\n");
         if(input) fclose(input);
-        if(output) fclose(output);
+        if(saidaAberta) fecharEscritor(output);
         return 1;
     }
 
@@ -53,7 +59,10 @@ int main(int argc, char *argv[]) {
             }
         }
 
-        fprintf(output, "L%d:INI@%d,%d", lab, inicio.x, inicio.y);
+        escreverCaractere(output, 'L');
+        escreverInteiro(output, lab);
+        escreverTexto(output, ":INI@");
+        escreverPosicao(output, inicio);
         
         Posicao saida = {-1, -1};
         visitados[inicio.x][inicio.y] = true;
@@ -69,13 +78,13 @@ int main(int argc, char *argv[]) {
             if(prox.x >= 0 && prox.x < linhas && prox.y >= 0 && prox.y < colunas &&
                labirinto[prox.x][prox.y] != '1' && !visitados[prox.x][prox.y] && !dead[prox.x][prox.y]) {
                 
-                fprintf(output, "|%s->%d,%d", dirs[i], prox.x, prox.y);
+                escreverMovimento(output, dirs[i], prox);
                 visitados[prox.x][prox.y] = true;
                 
                 if(encontrarSaida(labirinto, visitados, dead, linhas, colunas, prox, inicio, output, &saida)) {
                     encontrou = true;
                 } else {
-                    fprintf(output, "|BT@%d,%d->%d,%d", prox.x, prox.y, inicio.x, inicio.y);
+                    escreverRetrocesso(output, prox, inicio);
                     visitados[prox.x][prox.y] = false;
                     dead[prox.x][prox.y] = true; // Marca como dead-end
                 }
@@ -83,17 +92,42 @@ int main(int argc, char *argv[]) {
         }
 
         if(encontrou) {
-            fprintf(output, "|FIM@%d,%d\n", saida.x, saida.y);
+            escreverTexto(output, "|FIM@");
+            escreverPosicao(output, saida);
+            escreverCaractere(output, '\n');
         } else {
-            fprintf(output, "|FIM@-,-\n");
+            escreverTexto(output, "|FIM@-,-\n");
         }
     }
 
     fclose(input);
-    fclose(output);
+    fecharEscritor(output);
     return 0;
 }
 
+// "x,y"
+void escreverPosicao(EscritorRapido *output, Posicao pos) {
+    escreverInteiro(output, pos.x);
+    escreverCaractere(output, ',');
+    escreverInteiro(output, pos.y);
+}
+
+// "|D->x,y"
+void escreverMovimento(EscritorRapido *output, const char *dir, Posicao prox) {
+    escreverCaractere(output, '|');
+    escreverTexto(output, dir);
+    escreverTexto(output, "->");
+    escreverPosicao(output, prox);
+}
+
+// "|BT@x,y->x,y"
+void escreverRetrocesso(EscritorRapido *output, Posicao de, Posicao para) {
+    escreverTexto(output, "|BT@");
+    escreverPosicao(output, de);
+    escreverTexto(output, "->");
+    escreverPosicao(output, para);
+}
+
 bool isSaida(Posicao pos, int linhas, int colunas, Posicao inicio, char labirinto[][MAX_SIZE]) {
     return (pos.x == 0 || pos.x == linhas-1 || pos.y == 0 || pos.y == colunas-1) &&
            labirinto[pos.x][pos.y] == '0' &&
@@ -102,7 +136,7 @@ bool isSaida(Posicao pos, int linhas, int colunas, Posicao inicio, char labirint
 
 bool encontrarSaida(char labirinto[][MAX_SIZE], bool visitados[][MAX_SIZE], bool dead[][MAX_SIZE],
                    int linhas, int colunas, Posicao atual, Posicao inicio, 
-                   FILE *output, Posicao *saida) {
+                   EscritorRapido *output, Posicao *saida) {
     
     if(dead[atual.x][atual.y]) return false; // Pula células mortas
     
@@ -121,13 +155,13 @@ bool encontrarSaida(char labirinto[][MAX_SIZE], bool visitados[][MAX_SIZE], bool
         if(prox.x >= 0 && prox.x < linhas && prox.y >= 0 && prox.y < colunas &&
            labirinto[prox.x][prox.y] != '1' && !visitados[prox.x][prox.y] && !dead[prox.x][prox.y]) {
             
-            fprintf(output, "|%s->%d,%d", dirs[i], prox.x, prox.y);
+            escreverMovimento(output, dirs[i], prox);
             visitados[prox.x][prox.y] = true;
             
             if(encontrarSaida(labirinto, visitados, dead, linhas, colunas, prox, inicio, output, saida)) {
                 found = true;
             } else {
-                fprintf(output, "|BT@%d,%d->%d,%d", prox.x, prox.y, atual.x, atual.y);
+                escreverRetrocesso(output, prox, atual);
                 visitados[prox.x][prox.y] = false;
                 dead[prox.x][prox.y] = true; // Marca como dead-end
             }
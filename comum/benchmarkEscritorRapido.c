@@ -0,0 +1,154 @@
+#define _GNU_SOURCE  // fopencookie, para contar as chamadas de write do stdio
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "escritorRapido.h"
+// Compilar - gcc -O2 -o benchmarkEscritorRapido benchmarkEscritorRapido.c
+// Executar - ./benchmarkEscritorRapido [quantidade de registros] [arquivo temporário]
+// Compara fprintf por item com o EscritorRapido: tempo, vazão (MB/s) e chamadas de write
+
+#define QUANTIDADE_PADRAO 5000000
+
+// Registro típico das saídas: movimento do labirinto ("|D->x,y"), inteiros do quicksort e um pacote em hexadecimal
+typedef struct Registro {
+    int x, y, operacoes;
+    unsigned char bytes[6];
+} Registro;
+
+Registro *gerarRegistros(int quantidade) {
+    Registro *registros = malloc(sizeof(Registro) * quantidade);
+    if (!registros) return NULL;
+    srand(42);
+    for (int i = 0; i < quantidade; i++) {
+        registros[i].x = rand() % 100;
+        registros[i].y = rand() % 100;
+        registros[i].operacoes = rand();
+        for (int b = 0; b < 6; b++) registros[i].bytes[b] = (unsigned char)rand();
+    }
+    return registros;
+}
+
+#ifdef __GLIBC__
+// Contador das chamadas de write feitas pelo stdio (o FILE escreve através destas funções)
+typedef struct ArquivoContado {
+    int descritor;
+    long long chamadas;
+} ArquivoContado;
+
+ssize_t escreverContado(void *cookie, const char *dados, size_t tamanho) {
+    ArquivoContado *arquivo = cookie;
+    arquivo->chamadas++;
+    return write(arquivo->descritor, dados, tamanho);
+}
+
+int fecharContado(void *cookie) {
+    return close(((ArquivoContado *)cookie)->descritor);
+}
+#endif
+
+long long tamanhoArquivo(const char *caminho) {
+    FILE *arquivo = fopen(caminho, "rb");
+    if (!arquivo) return -1;
+    fseek(arquivo, 0, SEEK_END);
+    long long tamanho = ftell(arquivo);
+    fclose(arquivo);
+    return tamanho;
+}
+
+long long escreverComFprintf(const char *caminho, const Registro *registros, int quantidade, long long *chamadas) {
+    *chamadas = -1;
+#ifdef __GLIBC__
+    static ArquivoContado contado;
+    contado.descritor = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    contado.chamadas = 0;
+    cookie_io_functions_t funcoes = {NULL, escreverContado, NULL, fecharContado};
+    FILE *arquivo = contado.descritor >= 0 ? fopencookie(&contado, "w", funcoes) : NULL;
+    if (arquivo) setvbuf(arquivo, NULL, _IOFBF, BUFSIZ);  // Mesmo buffer de um fopen comum
+#else
+    FILE *arquivo = fopen(caminho, "w");
+#endif
+    if (!arquivo) return -1;
+    for (int i = 0; i < quantidade; i++) {
+        const Registro *r = &registros[i];
+        fprintf(arquivo, "|D->%d,%d", r->x, r->y);
+        fprintf(arquivo, "%d(%d),", i, r->operacoes);
+        fprintf(arquivo, "|%02X,%02X,%02X,%02X,%02X,%02X\n", r->bytes[0], r->bytes[1], r->bytes[2], r->bytes[3],
+                r->bytes[4], r->bytes[5]);
+    }
+    fclose(arquivo);
+#ifdef __GLIBC__
+    *chamadas = contado.chamadas;
+#endif
+    return tamanhoArquivo(caminho);
+}
+
+long long escreverComEscritor(const char *caminho, const Registro *registros, int quantidade, long long *chamadas) {
+    EscritorRapido escritor;
+    if (!abrirEscritor(&escritor, caminho)) return -1;
+    for (int i = 0; i < quantidade; i++) {
+        const Registro *r = &registros[i];
+        escreverTexto(&escritor, "|D->");
+        escreverInteiro(&escritor, r->x);
+        escreverCaractere(&escritor, ',');
+        escreverInteiro(&escritor, r->y);
+        escreverInteiro(&escritor, i);
+        escreverCaractere(&escritor, '(');
+        escreverInteiro(&escritor, r->operacoes);
+        escreverTexto(&escritor, "),|");
+        escreverHexadecimal(&escritor, r->bytes, 6, ',');
+        escreverCaractere(&escritor, '\n');
+    }
+    descarregarEscritor(&escritor);
+    *chamadas = escritor.descargas;
+    return fecharEscritor(&escritor) ? tamanhoArquivo(caminho) : -1;
+}
+
+int arquivosIguais(const char *a, const char *b) {
+    FILE *x = fopen(a, "rb"), *y = fopen(b, "rb");
+    int iguais = x && y;
+    while (iguais) {
+        int c = getc(x), d = getc(y);
+        if (c != d) iguais = 0;
+        if (c == EOF || d == EOF) break;
+    }
+    if (x) fclose(x);
+    if (y) fclose(y);
+    return iguais;
+}
+
+void imprimirMedicao(const char *nome, clock_t inicio, clock_t fim, long long bytes, long long chamadas) {
+    double segundos = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
+    double vazao = segundos > 0 ? (bytes / 1e6) / segundos : 0.0;
+    printf("%-10s %10.3f s %10.1f MB/s  %10lld chamadas de write\n", nome, segundos, vazao, chamadas);
+}
+
+int main(int argc, char **argv) {
+    int quantidade = argc > 1 ? atoi(argv[1]) : QUANTIDADE_PADRAO;
+    const char *caminho = argc > 2 ? argv[2] : "benchmarkEscritor.tmp";
+    char caminhoReferencia[4096];
+    snprintf(caminhoReferencia, sizeof(caminhoReferencia), "%s.fprintf", caminho);
+
+    Registro *registros = quantidade > 0 ? gerarRegistros(quantidade) : NULL;
+    if (!registros) {
+        fprintf(stderr, "Uso: %s [quantidade de registros] [arquivo temporário]\n", argv[0]);
+        return 1;
+    }
+    printf("Registros: %d\n", quantidade);
+
+    long long chamadas;
+    clock_t inicio = clock();
+    long long bytes = escreverComFprintf(caminhoReferencia, registros, quantidade, &chamadas);
+    imprimirMedicao("fprintf", inicio, clock(), bytes, chamadas);
+
+    inicio = clock();
+    bytes = escreverComEscritor(caminho, registros, quantidade, &chamadas);
+    imprimirMedicao("escritor", inicio, clock(), bytes, chamadas);
+
+    if (!arquivosIguais(caminho, caminhoReferencia)) {
+        printf("ERRO: as duas saídas são diferentes\n");
+    }
+    remove(caminho);
+    remove(caminhoReferencia);
+    free(registros);
+    return 0;
+}
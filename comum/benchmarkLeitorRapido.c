@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "leitorRapido.h"
+// Compilar - gcc -O2 -o benchmarkLeitorRapido benchmarkLeitorRapido.c
+// Executar - ./benchmarkLeitorRapido [quantidade de inteiros] [arquivo temporário]
+// Mede a vazão (MB/s) da leitura de inteiros com fscanf e com o LeitorRapido (mmap e buffer)
+
+#define QUANTIDADE_PADRAO 10000000
+
+// Gera um arquivo no mesmo formato das listas do quicksort: números com sinal separados por espaço
+long gerarArquivo(const char *caminho, int quantidade) {
+    FILE *arquivo = fopen(caminho, "w");
+    if (!arquivo) return -1;
+    srand(42);
+    for (int i = 0; i < quantidade; i++) {
+        int valor = (rand() % 2000000001) - 1000000000;
+        fprintf(arquivo, (i % 20 == 19) ? "%d\n" : "%d ", valor);
+    }
+    long tamanho = ftell(arquivo);
+    fclose(arquivo);
+    return tamanho;
+}
+
+long long lerComFscanf(const char *caminho, int *lidos) {
+    FILE *arquivo = fopen(caminho, "r");
+    long long soma = 0;
+    int valor;
+    *lidos = 0;
+    if (!arquivo) return 0;
+    while (fscanf(arquivo, "%d", &valor) == 1) {
+        soma += valor;
+        (*lidos)++;
+    }
+    fclose(arquivo);
+    return soma;
+}
+
+long long lerComLeitor(const char *caminho, int comBuffer, int *lidos) {
+    LeitorRapido leitor;
+    long long soma = 0;
+    int valor;
+    *lidos = 0;
+    if (!(comBuffer ? abrirLeitorComBuffer(&leitor, caminho) : abrirLeitor(&leitor, caminho))) return 0;
+    while (lerInteiro(&leitor, &valor)) {
+        soma += valor;
+        (*lidos)++;
+    }
+    fecharLeitor(&leitor);
+    return soma;
+}
+
+void imprimirMedicao(const char *nome, clock_t inicio, clock_t fim, long bytes, long long soma, int lidos) {
+    double segundos = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
+    double vazao = segundos > 0 ? (bytes / 1e6) / segundos : 0.0;
+    printf("%-16s %10.3f s %10.1f MB/s  (%d inteiros, soma %lld)\n", nome, segundos, vazao, lidos, soma);
+}
+
+int main(int argc, char **argv) {
+    int quantidade = argc > 1 ? atoi(argv[1]) : QUANTIDADE_PADRAO;
+    const char *caminho = argc > 2 ? argv[2] : "benchmarkLeitorRapido.tmp";
+
+    long bytes = gerarArquivo(caminho, quantidade);
+    if (bytes < 0) {
+        fprintf(stderr, "Erro ao criar o arquivo %s\n", caminho);
+        return 1;
+    }
+    printf("Arquivo: %s (%.1f MB)\n", caminho, bytes / 1e6);
+
+    int lidos;
+    clock_t inicio = clock();
+    long long soma = lerComFscanf(caminho, &lidos);
+    imprimirMedicao("fscanf", inicio, clock(), bytes, soma, lidos);
+
+    inicio = clock();
+    soma = lerComLeitor(caminho, 1, &lidos);
+    imprimirMedicao("leitor (buffer)", inicio, clock(), bytes, soma, lidos);
+
+    inicio = clock();
+    soma = lerComLeitor(caminho, 0, &lidos);
+    imprimirMedicao("leitor (mmap)", inicio, clock(), bytes, soma, lidos);
+
+    remove(caminho);
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "quickSortVetorial.h"
+// Compilar - gcc -O2 -o benchmarkQuickSortVetorial benchmarkQuickSortVetorial.c
+// Executar - ./benchmarkQuickSortVetorial [quantidade de chaves]
+// Mede a vazão (milhões de chaves/s e MB/s) do quicksort vetorial em cada caminho disponível, comparado ao qsort
+
+#define QUANTIDADE_PADRAO 10000000
+
+// Gerador xorshift64: rápido e reprodutível para qualquer quantidade de chaves
+uint64_t estadoAleatorio;
+
+uint64_t proximoAleatorio(void) {
+    estadoAleatorio ^= estadoAleatorio << 13;
+    estadoAleatorio ^= estadoAleatorio >> 7;
+    estadoAleatorio ^= estadoAleatorio << 17;
+    return estadoAleatorio;
+}
+
+void gerarChaves(void *dados, size_t quantidade, int tipo) {
+    estadoAleatorio = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < quantidade; i++) {
+        uint64_t aleatorio = proximoAleatorio();
+        if (tipo == 0) ((int32_t *)dados)[i] = (int32_t)aleatorio;
+        else if (tipo == 1) ((int64_t *)dados)[i] = (int64_t)aleatorio;
+        else ((double *)dados)[i] = (double)(int64_t)aleatorio / 1e6;
+    }
+}
+
+int compararInt32(const void *a, const void *b) {
+    int32_t x = *(const int32_t *)a, y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+int compararInt64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+int compararDouble(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int estaOrdenado(const void *dados, size_t quantidade, int tipo) {
+    for (size_t i = 1; i < quantidade; i++) {
+        if (tipo == 0 && ((const int32_t *)dados)[i - 1] > ((const int32_t *)dados)[i]) return 0;
+        if (tipo == 1 && ((const int64_t *)dados)[i - 1] > ((const int64_t *)dados)[i]) return 0;
+        if (tipo == 2 && ((const double *)dados)[i - 1] > ((const double *)dados)[i]) return 0;
+    }
+    return 1;
+}
+
+void imprimirMedicao(const char *tipo, const char *caminho, clock_t inicio, clock_t fim, size_t quantidade,
+                     size_t tamanhoChave, int ordenado) {
+    double segundos = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
+    double chavesPorSegundo = segundos > 0 ? (quantidade / 1e6) / segundos : 0.0;
+    double vazao = segundos > 0 ? (quantidade * tamanhoChave / 1e6) / segundos : 0.0;
+    printf("%-7s %-8s %10.3f s %10.1f Mchaves/s %10.1f MB/s%s\n", tipo, caminho, segundos, chavesPorSegundo, vazao,
+           ordenado ? "" : "  ERRO: saída fora de ordem");
+}
+
+int main(int argc, char **argv) {
+    size_t quantidade = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : QUANTIDADE_PADRAO;
+    const char *nomesTipos[3] = {"int32", "int64", "double"};
+    const size_t tamanhos[3] = {sizeof(int32_t), sizeof(int64_t), sizeof(double)};
+    int (*comparadores[3])(const void *, const void *) = {compararInt32, compararInt64, compararDouble};
+
+    void *dados = malloc(quantidade * sizeof(int64_t));
+    if (!dados) {
+        fprintf(stderr, "Erro de alocação para %zu chaves\n", quantidade);
+        return 1;
+    }
+
+    NivelVetorial disponivel = detectarNivelVetorial();
+    printf("Chaves: %zu, caminho mais rápido disponível: %s\n", quantidade, nomeNivelVetorial(disponivel));
+
+    for (int tipo = 0; tipo < 3; tipo++) {
+        gerarChaves(dados, quantidade, tipo);
+        clock_t inicio = clock();
+        qsort(dados, quantidade, tamanhos[tipo], comparadores[tipo]);
+        imprimirMedicao(nomesTipos[tipo], "qsort", inicio, clock(), quantidade, tamanhos[tipo],
+                        estaOrdenado(dados, quantidade, tipo));
+
+        for (int nivel = NIVEL_ESCALAR; nivel <= (int)disponivel; nivel++) {
+            gerarChaves(dados, quantidade, tipo);
+            inicio = clock();
+            if (tipo == 0) ordenarInt32Nivel((int32_t *)dados, quantidade, (NivelVetorial)nivel);
+            else if (tipo == 1) ordenarInt64Nivel((int64_t *)dados, quantidade, (NivelVetorial)nivel);
+            else ordenarDoubleNivel((double *)dados, quantidade, (NivelVetorial)nivel);
+            imprimirMedicao(nomesTipos[tipo], nomeNivelVetorial((NivelVetorial)nivel), inicio, clock(), quantidade,
+                            tamanhos[tipo], estaOrdenado(dados, quantidade, tipo));
+        }
+    }
+
+    free(dados);
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "janelaReordenacao.h"
+#include "heapDario.h"
+// Compilar - gcc -O2 -o benchmarkReordenacao benchmarkReordenacao.c
+// Executar - ./benchmarkReordenacao [quantidade de pacotes] [pacotes por bloco]
+// Compara a vazão (milhões de pacotes/s) do min-heap e da janela de reordenação na entrega em ordem
+
+#define QUANTIDADE_PADRAO 5000000
+#define BLOCO_PADRAO 64
+
+// Entrada do heap (4-ário compartilhado): número do pacote e handle dos dados, como no datagrama.c
+typedef struct EntradaHeap {
+    int numero;
+    int handle;
+} EntradaHeap;
+
+#define MENOR_ENTRADA(a, b) ((a).numero < (b).numero)
+DEFINIR_HEAP_DARIO(HeapEntradas, EntradaHeap, 4, MENOR_ENTRADA)
+
+HeapEntradas heap;
+
+// Números 0..n-1 embaralhados dentro de cada bloco (desordem limitada ao tamanho do bloco)
+int *gerarChegadas(int quantidade, int bloco) {
+    int *numeros = malloc(sizeof(int) * quantidade);
+    if (!numeros) return NULL;
+    srand(42);
+    for (int i = 0; i < quantidade; i++) numeros[i] = i;
+    for (int inicio = 0; inicio < quantidade; inicio += bloco) {
+        int fim = inicio + bloco < quantidade ? inicio + bloco : quantidade;
+        for (int i = fim - 1; i > inicio; i--) {
+            int j = inicio + rand() % (i - inicio + 1);
+            int temp = numeros[i];
+            numeros[i] = numeros[j];
+            numeros[j] = temp;
+        }
+    }
+    return numeros;
+}
+
+// Mesmo laço do datagrama.c: insere um bloco e entrega tudo o que já está em sequência
+long long executarHeap(const int *chegadas, int quantidade, int bloco) {
+    long long soma = 0;
+    int posicaoSequencia = 0;
+    for (int inicio = 0; inicio < quantidade; inicio += bloco) {
+        for (int i = inicio; i < inicio + bloco && i < quantidade; i++) {
+            EntradaHeap entrada = {chegadas[i], i};
+            inserirHeapEntradas(&heap, entrada);
+        }
+        while (!vazioHeapEntradas(&heap) && heap.nos[0].numero == posicaoSequencia) {
+            soma += removerMinimoHeapEntradas(&heap).handle;
+            posicaoSequencia++;
+        }
+    }
+    return soma;
+}
+
+long long executarJanela(const int *chegadas, int quantidade, int bloco) {
+    JanelaReordenacao janela;
+    long long soma = 0;
+    int handle;
+    if (!iniciarJanela(&janela, bloco, 0)) return -1;
+    for (int inicio = 0; inicio < quantidade; inicio += bloco) {
+        for (int i = inicio; i < inicio + bloco && i < quantidade; i++) {
+            inserirNaJanela(&janela, chegadas[i], i);
+        }
+        while (retirarDaJanela(&janela, &handle)) {
+            soma += handle;
+        }
+    }
+    liberarJanela(&janela);
+    return soma;
+}
+
+void imprimirMedicao(const char *nome, clock_t inicio, clock_t fim, int quantidade, long long soma) {
+    double segundos = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
+    double vazao = segundos > 0 ? (quantidade / 1e6) / segundos : 0.0;
+    printf("%-8s %10.3f s %10.1f Mpacotes/s  (soma dos handles %lld)\n", nome, segundos, vazao, soma);
+}
+
+int main(int argc, char **argv) {
+    int quantidade = argc > 1 ? atoi(argv[1]) : QUANTIDADE_PADRAO;
+    int bloco = argc > 2 ? atoi(argv[2]) : BLOCO_PADRAO;
+    if (quantidade <= 0 || bloco <= 0) {
+        fprintf(stderr, "Uso: %s [quantidade de pacotes] [pacotes por bloco]\n", argv[0]);
+        return 1;
+    }
+
+    int *chegadas = gerarChegadas(quantidade, bloco);
+    if (!chegadas || !iniciarHeapEntradas(&heap, bloco)) {
+        fprintf(stderr, "Erro de alocação para %d pacotes\n", quantidade);
+        return 1;
+    }
+    printf("Pacotes: %d, pacotes por bloco: %d\n", quantidade, bloco);
+
+    clock_t inicio = clock();
+    long long soma = executarHeap(chegadas, quantidade, bloco);
+    imprimirMedicao("heap", inicio, clock(), quantidade, soma);
+
+    inicio = clock();
+    soma = executarJanela(chegadas, quantidade, bloco);
+    imprimirMedicao("janela", inicio, clock(), quantidade, soma);
+
+    free(chegadas);
+    liberarHeapEntradas(&heap);
+    return 0;
+}
@@ -0,0 +1,133 @@
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+// Compilar - gcc -O2 -o benchmarkTransportadora benchmarkTransportadora.c
+// Executar - ./benchmarkTransportadora [executável da transportadora] [entrada] [repetições]
+// Mede o tempo da transportadora com e sem a redução da mochila (-sem-reducao) na entrada e numa cópia dela
+// com pesos, volumes e limites multiplicados por 10, e confere que as saídas são iguais. As duas execuções
+// usam -dp, para que o branch-and-bound automático não troque o algoritmo medido
+
+#define EXECUTAVEL_PADRAO "../4_programacao Dinamica/transportadora"
+#define ENTRADA_PADRAO "../4_programacao Dinamica/transportadora.input.txt"
+#define REPETICOES_PADRAO 3
+#define FATOR_ESCALA 10
+#define ARQUIVO_ESCALADO "benchmarkTransportadora.x10.tmp"
+#define SAIDA_REDUCAO "benchmarkTransportadora.saida.tmp"
+#define SAIDA_SEM_REDUCAO "benchmarkTransportadora.saida.sem.tmp"
+
+// Copia a entrada multiplicando pesos, volumes e limites por 'fator' (os valores não mudam)
+int escalarEntrada(const char *origem, const char *destino, int fator) {
+    FILE *entrada = fopen(origem, "r");
+    FILE *saida = fopen(destino, "w");
+    if (!entrada || !saida) {
+        if (entrada) fclose(entrada);
+        if (saida) fclose(saida);
+        return 0;
+    }
+    int ok = 1, quantidade, peso, volume;
+    char codigo[64], valor[64];
+    if (fscanf(entrada, "%d", &quantidade) != 1) ok = 0;
+    if (ok) fprintf(saida, "%d\n", quantidade);
+    for (int i = 0; ok && i < quantidade; i++) {
+        if (fscanf(entrada, "%63s %d %d", codigo, &peso, &volume) != 3) ok = 0;
+        else fprintf(saida, "%s %d %d\n", codigo, peso * fator, volume * fator);
+    }
+    if (ok && fscanf(entrada, "%d", &quantidade) != 1) ok = 0;
+    if (ok) fprintf(saida, "%d\n", quantidade);
+    for (int i = 0; ok && i < quantidade; i++) {
+        if (fscanf(entrada, "%63s %63s %d %d", codigo, valor, &peso, &volume) != 4) ok = 0;
+        else fprintf(saida, "%s %s %d %d\n", codigo, valor, peso * fator, volume * fator);
+    }
+    fclose(entrada);
+    fclose(saida);
+    return ok;
+}
+
+double agoraSegundos(void) {
+    struct timespec instante;
+    clock_gettime(CLOCK_MONOTONIC, &instante);
+    return instante.tv_sec + instante.tv_nsec / 1e9;
+}
+
+// Executa a transportadora com -dp (saída do terminal descartada); retorna o tempo de parede em segundos ou -1
+double executarTransportadora(const char *executavel, const char *entrada, const char *saida, const char *opcao) {
+    double inicio = agoraSegundos();
+    pid_t filho = fork();
+    if (filho < 0) return -1;
+    if (filho == 0) {
+        int nulo = open("/dev/null", O_WRONLY);
+        if (nulo >= 0) dup2(nulo, STDOUT_FILENO);
+        if (opcao) execl(executavel, executavel, entrada, saida, "-dp", opcao, (char *)NULL);
+        else execl(executavel, executavel, entrada, saida, "-dp", (char *)NULL);
+        _exit(127);
+    }
+    int estado;
+    if (waitpid(filho, &estado, 0) < 0 || !WIFEXITED(estado) || WEXITSTATUS(estado) != 0) return -1;
+    return agoraSegundos() - inicio;
+}
+
+// Menor tempo entre as repetições
+double medirMelhor(const char *executavel, const char *entrada, const char *saida, const char *opcao,
+                   int repeticoes) {
+    double melhor = -1;
+    for (int r = 0; r < repeticoes; r++) {
+        double tempo = executarTransportadora(executavel, entrada, saida, opcao);
+        if (tempo < 0) return -1;
+        if (melhor < 0 || tempo < melhor) melhor = tempo;
+    }
+    return melhor;
+}
+
+int arquivosIguais(const char *a, const char *b) {
+    FILE *x = fopen(a, "rb"), *y = fopen(b, "rb");
+    int iguais = x && y;
+    while (iguais) {
+        int c = getc(x), d = getc(y);
+        if (c != d) iguais = 0;
+        if (c == EOF || d == EOF) break;
+    }
+    if (x) fclose(x);
+    if (y) fclose(y);
+    return iguais;
+}
+
+// Mede a entrada com e sem redução; retorna 0 se alguma execução falhou
+int compararReducao(const char *nome, const char *executavel, const char *entrada, int repeticoes) {
+    double comReducao = medirMelhor(executavel, entrada, SAIDA_REDUCAO, NULL, repeticoes);
+    double semReducao = medirMelhor(executavel, entrada, SAIDA_SEM_REDUCAO, "-sem-reducao", repeticoes);
+    if (comReducao < 0 || semReducao < 0) {
+        fprintf(stderr, "Erro ao executar %s com %s\n", executavel, entrada);
+        return 0;
+    }
+    printf("%-12s %12.3f s %12.3f s %9.1fx\n", nome, semReducao, comReducao,
+           comReducao > 0 ? semReducao / comReducao : 0.0);
+    if (!arquivosIguais(SAIDA_REDUCAO, SAIDA_SEM_REDUCAO)) {
+        printf("ERRO: as saídas com e sem redução são diferentes (%s)\n", nome);
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    const char *executavel = argc > 1 ? argv[1] : EXECUTAVEL_PADRAO;
+    const char *entrada = argc > 2 ? argv[2] : ENTRADA_PADRAO;
+    int repeticoes = argc > 3 ? atoi(argv[3]) : REPETICOES_PADRAO;
+    if (repeticoes <= 0 || !escalarEntrada(entrada, ARQUIVO_ESCALADO, FATOR_ESCALA)) {
+        fprintf(stderr, "Uso: %s [executável da transportadora] [entrada] [repetições]\n", argv[0]);
+        return 1;
+    }
+
+    printf("Melhor de %d execuções (tempo de parede)\n", repeticoes);
+    printf("%-12s %14s %14s %10s\n", "entrada", "-sem-reducao", "com reducao", "ganho");
+    int ok = compararReducao("original", executavel, entrada, repeticoes) &&
+             compararReducao("x10", executavel, ARQUIVO_ESCALADO, repeticoes);
+
+    remove(ARQUIVO_ESCALADO);
+    remove(SAIDA_REDUCAO);
+    remove(SAIDA_SEM_REDUCAO);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+#ifndef ESCRITOR_RAPIDO_H
+#define ESCRITOR_RAPIDO_H
+
+/*
+   Escritor com buffer para os arquivos de saída dos exercícios, par do
+   leitorRapido.h. Substitui os fprintf por item dos drivers: os trechos são
+   acumulados num buffer grande em espaço de usuário, inteiros e bytes
+   hexadecimais são convertidos à mão e cada descarga é um único write (um
+   fwrite do buffer inteiro no Windows).
+
+   Uso:
+     EscritorRapido saida;
+     if (!abrirEscritor(&saida, "saida.txt")) { ... }
+     escreverTexto(&saida, "L");
+     escreverInteiro(&saida, 42);
+     escreverCaractere(&saida, '\n');
+     fecharEscritor(&saida);
+
+   Números com casas decimais usam escreverFormatado (vsnprintf direto no
+   buffer), que mantém exatamente o arredondamento do fprintf.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define TAMANHO_BUFFER_ESCRITOR (1 << 20)  // Bytes acumulados antes de cada write
+
+typedef struct EscritorRapido {
+    int descritor;        // Arquivo de saída (POSIX)
+    FILE *arquivo;        // Arquivo de saída (Windows)
+    char *buffer;
+    size_t usado;
+    size_t capacidade;
+    int erro;             // 1 depois de uma falha de escrita
+    long long descargas;  // Chamadas de write feitas (para medições)
+} EscritorRapido;
+
+//----------------[ Abertura, descarga e fechamento ]----------------
+
+// Cria (ou trunca) o arquivo de saída; retorna 0 se não for possível
+static inline int abrirEscritor(EscritorRapido *escritor, const char *caminho) {
+    memset(escritor, 0, sizeof(*escritor));
+    escritor->descritor = -1;
+    escritor->buffer = malloc(TAMANHO_BUFFER_ESCRITOR);
+    if (!escritor->buffer) return 0;
+    escritor->capacidade = TAMANHO_BUFFER_ESCRITOR;
+#ifndef _WIN32
+    escritor->descritor = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (escritor->descritor >= 0) return 1;
+#else
+    escritor->arquivo = fopen(caminho, "wb");
+    if (escritor->arquivo) return 1;
+#endif
+    free(escritor->buffer);
+    escritor->buffer = NULL;
+    return 0;
+}
+
+// Grava todo o buffer com um único write (repetido só em escritas parciais)
+static inline void descarregarEscritor(EscritorRapido *escritor) {
+    size_t enviados = 0;
+    while (enviados < escritor->usado && !escritor->erro) {
+#ifndef _WIN32
+        ssize_t escritos = write(escritor->descritor, escritor->buffer + enviados, escritor->usado - enviados);
+        escritor->descargas++;
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            escritor->erro = 1;
+            break;
+        }
+        enviados += (size_t)escritos;
+#else
+        size_t escritos = fwrite(escritor->buffer + enviados, 1, escritor->usado - enviados, escritor->arquivo);
+        escritor->descargas++;
+        if (escritos == 0) escritor->erro = 1;
+        enviados += escritos;
+#endif
+    }
+    escritor->usado = 0;
+}
+
+// Descarrega e fecha o arquivo; retorna 0 se alguma escrita falhou
+static inline int fecharEscritor(EscritorRapido *escritor) {
+    descarregarEscritor(escritor);
+#ifndef _WIN32
+    if (escritor->descritor >= 0 && close(escritor->descritor) != 0) escritor->erro = 1;
+#else
+    if (escritor->arquivo && fclose(escritor->arquivo) != 0) escritor->erro = 1;
+#endif
+    int sucesso = !escritor->erro;
+    free(escritor->buffer);
+    memset(escritor, 0, sizeof(*escritor));
+    escritor->descritor = -1;
+    return sucesso;
+}
+
+//----------------[ Escrita ]----------------
+
+// Retorna espaço para 'tamanho' bytes no fim do buffer (crescendo-o só para trechos maiores que ele);
+// quem escreve avança escritor->usado
+static inline char *reservarEscritor(EscritorRapido *escritor, size_t tamanho) {
+    if (escritor->capacidade - escritor->usado < tamanho) {
+        descarregarEscritor(escritor);
+        if (tamanho > escritor->capacidade) {
+            char *novo = realloc(escritor->buffer, tamanho);
+            if (!novo) {
+                fprintf(stderr, "Erro de alocação do buffer de saída\n");
+                exit(1);
+            }
+            escritor->buffer = novo;
+            escritor->capacidade = tamanho;
+        }
+    }
+    return escritor->buffer + escritor->usado;
+}
+
+static inline void escreverBytes(EscritorRapido *escritor, const void *dados, size_t tamanho) {
+    memcpy(reservarEscritor(escritor, tamanho), dados, tamanho);
+    escritor->usado += tamanho;
+}
+
+static inline void escreverTexto(EscritorRapido *escritor, const char *texto) {
+    escreverBytes(escritor, texto, strlen(texto));
+}
+
+static inline void escreverCaractere(EscritorRapido *escritor, char c) {
+    if (escritor->usado == escritor->capacidade) reservarEscritor(escritor, 1);
+    escritor->buffer[escritor->usado++] = c;
+}
+
+// Copia os bytes trocando cada ocorrência de 'de' por 'para'
+static inline void escreverTrocando(EscritorRapido *escritor, const char *dados, size_t tamanho, char de, char para) {
+    char *destino = reservarEscritor(escritor, tamanho);
+    for (size_t k = 0; k < tamanho; k++) {
+        destino[k] = dados[k] == de ? para : dados[k];
+    }
+    escritor->usado += tamanho;
+}
+
+// Escreve cada byte como dois dígitos hexadecimais maiúsculos, separados por 'separador' ('\0' para nenhum)
+static inline void escreverHexadecimal(EscritorRapido *escritor, const unsigned char *bytes, size_t quantidade,
+                                       char separador) {
+    static const char simbolos[16] = "0123456789ABCDEF";
+    if (quantidade == 0) return;
+    size_t passo = separador ? 3 : 2;
+    char *destino = reservarEscritor(escritor, passo * quantidade - (separador ? 1 : 0));
+    for (size_t b = 0; b < quantidade; b++) {
+        if (separador && b > 0) *destino++ = separador;
+        *destino++ = simbolos[bytes[b] >> 4];
+        *destino++ = simbolos[bytes[b] & 0xF];
+    }
+    escritor->usado += passo * quantidade - (separador ? 1 : 0);
+}
+
+// Escreve um inteiro em decimal (equivalente a "%lld"), dois dígitos por vez
+static inline void escreverInteiro(EscritorRapido *escritor, long long valor) {
+    static const char pares[201] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char digitos[24];
+    char *fim = digitos + sizeof(digitos), *inicio = fim;
+    unsigned long long absoluto = valor < 0 ? 0ULL - (unsigned long long)valor : (unsigned long long)valor;
+    while (absoluto >= 100) {
+        unsigned int resto = (unsigned int)(absoluto % 100);
+        absoluto /= 100;
+        inicio -= 2;
+        memcpy(inicio, pares + 2 * resto, 2);
+    }
+    if (absoluto >= 10) {
+        inicio -= 2;
+        memcpy(inicio, pares + 2 * absoluto, 2);
+    } else {
+        *--inicio = (char)('0' + absoluto);
+    }
+    if (valor < 0) *--inicio = '-';
+    escreverBytes(escritor, inicio, (size_t)(fim - inicio));
+}
+
+// Formatação geral (casas decimais etc.) feita direto no buffer; retorna o número de bytes escritos
+static inline int escreverFormatado(EscritorRapido *escritor, const char *formato, ...) {
+    va_list argumentos;
+    va_start(argumentos, formato);
+    int tamanho = vsnprintf(escritor->buffer + escritor->usado, escritor->capacidade - escritor->usado, formato,
+                            argumentos);
+    va_end(argumentos);
+    if (tamanho < 0) return tamanho;
+    if ((size_t)tamanho >= escritor->capacidade - escritor->usado) {
+        // Não coube: abre espaço e formata de novo
+        reservarEscritor(escritor, (size_t)tamanho + 1);
+        va_start(argumentos, formato);
+        vsnprintf(escritor->buffer + escritor->usado, escritor->capacidade - escritor->usado, formato, argumentos);
+        va_end(argumentos);
+    }
+    escritor->usado += (size_t)tamanho;
+    return tamanho;
+}
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef HEAP_DARIO_H
+#define HEAP_DARIO_H
+
+/*
+   Min-heap d-ário iterativo, gerado para qualquer tipo de elemento e prioridade.
+
+   DEFINIR_HEAP_DARIO(Nome, Tipo, ARIDADE, MENOR) gera o tipo Nome e as funções
+     iniciarNome, liberarNome, inserirNome, removerMinimoNome, vazioNome
+   sobre um vetor próprio, além das funções de vetor
+     subirNome, descerNome, construirNome
+   que trabalham num array qualquer (para quem já guarda os elementos num vetor).
+
+   MENOR(a, b) recebe dois elementos e diz se a tem prioridade sobre b.
+   A movimentação é feita com um "buraco": o elemento em movimento fica numa
+   variável e só os elementos que cedem lugar são copiados, sem trocas.
+
+   Com ARIDADE 4 os filhos de um nó ficam lado a lado; o vetor interno é
+   deslocado para que cada grupo de irmãos comece num múltiplo de ARIDADE
+   elementos a partir de um endereço alinhado a ALINHAMENTO_HEAP_DARIO bytes.
+   Com ARIDADE 2 e o mesmo MENOR, a ordem de retirada dos empates é a mesma do
+   heap binário recursivo clássico.
+
+   Uso:
+     #define MENOR_PACOTE(a, b) ((a).numero < (b).numero)
+     DEFINIR_HEAP_DARIO(HeapPacotes, Pacote, 4, MENOR_PACOTE)
+     HeapPacotes heap;
+     iniciarHeapPacotes(&heap, 64);
+     inserirHeapPacotes(&heap, p);
+     Pacote menor = removerMinimoHeapPacotes(&heap);
+     liberarHeapPacotes(&heap);
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ALINHAMENTO_HEAP_DARIO 64  // Tamanho de uma linha de cache
+
+#define DEFINIR_HEAP_DARIO(Nome, Tipo, ARIDADE, MENOR)                                                   \
+    typedef struct Nome {                                                                                \
+        Tipo *nos;       /* Raiz em nos[0]; filhos de i em nos[ARIDADE*i + 1 .. ARIDADE*i + ARIDADE] */  \
+        void *memoria;   /* Bloco alocado (nos aponta para dentro dele, já alinhado) */                  \
+        int tamanho;                                                                                     \
+        int capacidade;                                                                                  \
+    } Nome;                                                                                              \
+                                                                                                         \
+    /* Sobe o elemento em nos[indice] até a posição correta */                                           \
+    static inline void subir##Nome(Tipo nos[], int indice) {                                             \
+        Tipo valor = nos[indice];                                                                        \
+        while (indice > 0) {                                                                             \
+            int pai = (indice - 1) / (ARIDADE);                                                          \
+            if (!(MENOR(valor, nos[pai]))) break;                                                        \
+            nos[indice] = nos[pai];                                                                      \
+            indice = pai;                                                                                \
+        }                                                                                                \
+        nos[indice] = valor;                                                                             \
+    }                                                                                                    \
+                                                                                                         \
+    /* Desce o elemento em nos[indice] num heap com 'tamanho' elementos */                               \
+    static inline void descer##Nome(Tipo nos[], int tamanho, int indice) {                               \
+        Tipo valor = nos[indice];                                                                        \
+        while (1) {                                                                                      \
+            int primeiro = (ARIDADE) * indice + 1;                                                       \
+            if (primeiro >= tamanho) break;                                                              \
+            int ultimo = primeiro + (ARIDADE) < tamanho ? primeiro + (ARIDADE) : tamanho;                \
+            int menor = primeiro;                                                                        \
+            for (int filho = primeiro + 1; filho < ultimo; filho++) {                                    \
+                if (MENOR(nos[filho], nos[menor])) menor = filho;                                        \
+            }                                                                                            \
+            if (!(MENOR(nos[menor], valor))) break;                                                      \
+            nos[indice] = nos[menor];                                                                    \
+            indice = menor;                                                                              \
+        }                                                                                                \
+        nos[indice] = valor;                                                                             \
+    }                                                                                                    \
+                                                                                                         \
+    /* Transforma nos[0..tamanho-1] em heap (Floyd, de baixo para cima) */                               \
+    static inline void construir##Nome(Tipo nos[], int tamanho) {                                        \
+        for (int i = (tamanho - 2) / (ARIDADE); i >= 0; i--) {                                           \
+            descer##Nome(nos, tamanho, i);                                                               \
+        }                                                                                                \
+    }                                                                                                    \
+                                                                                                         \
+    /* Troca o vetor por um com espaço para 'capacidade' elementos; retorna 0 se faltar memória */       \
+    static inline int realocar##Nome(Nome *heap, int capacidade) {                                       \
+        size_t deslocamento = (ARIDADE) - 1;                                                             \
+        void *memoria = malloc((deslocamento + (size_t)capacidade) * sizeof(Tipo) + ALINHAMENTO_HEAP_DARIO); \
+        if (!memoria) return 0;                                                                          \
+        uintptr_t endereco = ((uintptr_t)memoria + ALINHAMENTO_HEAP_DARIO - 1) & ~(uintptr_t)(ALINHAMENTO_HEAP_DARIO - 1); \
+        Tipo *nos = (Tipo *)endereco + deslocamento;                                                     \
+        if (heap->tamanho > 0) memcpy(nos, heap->nos, (size_t)heap->tamanho * sizeof(Tipo));             \
+        free(heap->memoria);                                                                             \
+        heap->memoria = memoria;                                                                         \
+        heap->nos = nos;                                                                                 \
+        heap->capacidade = capacidade;                                                                   \
+        return 1;                                                                                        \
+    }                                                                                                    \
+                                                                                                         \
+    static inline int iniciar##Nome(Nome *heap, int capacidade) {                                        \
+        memset(heap, 0, sizeof(*heap));                                                                  \
+        return realocar##Nome(heap, capacidade > 0 ? capacidade : 1);                                    \
+    }                                                                                                    \
+                                                                                                         \
+    static inline void liberar##Nome(Nome *heap) {                                                       \
+        free(heap->memoria);                                                                             \
+        memset(heap, 0, sizeof(*heap));                                                                  \
+    }                                                                                                    \
+                                                                                                         \
+    static inline int vazio##Nome(const Nome *heap) {                                                    \
+        return heap->tamanho == 0;                                                                       \
+    }                                                                                                    \
+                                                                                                         \
+    /* Insere dobrando a capacidade quando necessário; retorna 0 se faltar memória */                    \
+    static inline int inserir##Nome(Nome *heap, Tipo valor) {                                            \
+        if (heap->tamanho >= heap->capacidade && !realocar##Nome(heap, heap->capacidade * 2)) return 0;  \
+        heap->nos[heap->tamanho] = valor;                                                                \
+        subir##Nome(heap->nos, heap->tamanho);                                                           \
+        heap->tamanho++;                                                                                 \
+        return 1;                                                                                        \
+    }                                                                                                    \
+                                                                                                         \
+    /* Retira a raiz; o heap não pode estar vazio */                                                     \
+    static inline Tipo removerMinimo##Nome(Nome *heap) {                                                 \
+        Tipo raiz = heap->nos[0];                                                                        \
+        heap->tamanho--;                                                                                 \
+        if (heap->tamanho > 0) {                                                                         \
+            heap->nos[0] = heap->nos[heap->tamanho];                                                     \
+            descer##Nome(heap->nos, heap->tamanho, 0);                                                   \
+        }                                                                                                \
+        return raiz;                                                                                     \
+    }
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef JANELA_REORDENACAO_H
+#define JANELA_REORDENACAO_H
+
+/*
+   Janela de reordenação (buffer circular) para entregar em ordem pacotes que
+   chegam fora de ordem com desordem limitada, alternativa ao min-heap dos
+   exercícios de datagrama.
+
+   Cada pacote ocupa o slot (numero & mascara), ou seja, a posição
+   numero - base a partir do próximo número esperado; um bitmap marca os slots
+   ocupados. Inserir e retirar são O(1); a capacidade (potência de dois) dobra
+   quando chega um número mais distante que a janela atual.
+
+   Uso:
+     JanelaReordenacao janela;
+     iniciarJanela(&janela, 64, 0);
+     inserirNaJanela(&janela, numeroPacote, handle);
+     while (retirarDaJanela(&janela, &handle)) { ... entrega em ordem ... }
+     liberarJanela(&janela);
+
+   Números repetidos ou já entregues travam a janela (nada mais é entregue),
+   reproduzindo o que acontece com o heap: o número antigo fica na raiz e nunca
+   é igual ao próximo esperado.
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct JanelaReordenacao {
+    int *valores;          // Handle guardado para cada slot ocupado
+    uint64_t *presentes;   // Bit do slot ligado quando o número chegou
+    uint64_t *repetidos;   // Bit ligado quando o número chegou mais de uma vez
+    int capacidade;        // Potência de dois
+    int base;              // Próximo número a ser entregue
+    int quantidade;        // Pacotes guardados
+    int travada;           // 1 depois de um número repetido ou já entregue
+} JanelaReordenacao;
+
+static inline int palavrasBitmapJanela(int capacidade) {
+    return (capacidade + 63) / 64;
+}
+
+static inline int bitJanelaLigado(const uint64_t *bitmap, int slot) {
+    return (int)((bitmap[slot >> 6] >> (slot & 63)) & 1);
+}
+
+static inline void ligarBitJanela(uint64_t *bitmap, int slot) {
+    bitmap[slot >> 6] |= 1ULL << (slot & 63);
+}
+
+static inline void desligarBitJanela(uint64_t *bitmap, int slot) {
+    bitmap[slot >> 6] &= ~(1ULL << (slot & 63));
+}
+
+// Aloca uma janela com pelo menos 'capacidadeInicial' slots; retorna 0 se faltar memória
+static inline int iniciarJanela(JanelaReordenacao *janela, int capacidadeInicial, int primeiroNumero) {
+    int capacidade = 64;
+    while (capacidade < capacidadeInicial) capacidade *= 2;
+
+    memset(janela, 0, sizeof(*janela));
+    janela->valores = malloc(sizeof(int) * capacidade);
+    janela->presentes = calloc(palavrasBitmapJanela(capacidade), sizeof(uint64_t));
+    janela->repetidos = calloc(palavrasBitmapJanela(capacidade), sizeof(uint64_t));
+    if (!janela->valores || !janela->presentes || !janela->repetidos) {
+        free(janela->valores);
+        free(janela->presentes);
+        free(janela->repetidos);
+        return 0;
+    }
+    janela->capacidade = capacidade;
+    janela->base = primeiroNumero;
+    return 1;
+}
+
+static inline void liberarJanela(JanelaReordenacao *janela) {
+    free(janela->valores);
+    free(janela->presentes);
+    free(janela->repetidos);
+    memset(janela, 0, sizeof(*janela));
+}
+
+// Dobra a capacidade até caber o deslocamento pedido, reposicionando os slots ocupados
+static inline int crescerJanela(JanelaReordenacao *janela, int deslocamento) {
+    int novaCapacidade = janela->capacidade;
+    while (novaCapacidade <= deslocamento) {
+        if (novaCapacidade > INT32_MAX / 2) return 0;
+        novaCapacidade *= 2;
+    }
+
+    int *valores = malloc(sizeof(int) * novaCapacidade);
+    uint64_t *presentes = calloc(palavrasBitmapJanela(novaCapacidade), sizeof(uint64_t));
+    uint64_t *repetidos = calloc(palavrasBitmapJanela(novaCapacidade), sizeof(uint64_t));
+    if (!valores || !presentes || !repetidos) {
+        free(valores);
+        free(presentes);
+        free(repetidos);
+        return 0;
+    }
+
+    int mascaraAntiga = janela->capacidade - 1, novaMascara = novaCapacidade - 1;
+    for (int d = 0; d < janela->capacidade; d++) {
+        int antigo = (janela->base + d) & mascaraAntiga;
+        if (!bitJanelaLigado(janela->presentes, antigo)) continue;
+        int novo = (janela->base + d) & novaMascara;
+        valores[novo] = janela->valores[antigo];
+        ligarBitJanela(presentes, novo);
+        if (bitJanelaLigado(janela->repetidos, antigo)) ligarBitJanela(repetidos, novo);
+    }
+
+    free(janela->valores);
+    free(janela->presentes);
+    free(janela->repetidos);
+    janela->valores = valores;
+    janela->presentes = presentes;
+    janela->repetidos = repetidos;
+    janela->capacidade = novaCapacidade;
+    return 1;
+}
+
+// Guarda o handle do pacote 'numero'; retorna 0 se faltar memória
+static inline int inserirNaJanela(JanelaReordenacao *janela, int numero, int valor) {
+    long long deslocamento = (long long)numero - janela->base;
+    if (deslocamento < 0) {
+        janela->travada = 1;  // Número já entregue
+        return 1;
+    }
+    if (deslocamento >= janela->capacidade && !crescerJanela(janela, (int)deslocamento)) {
+        return 0;
+    }
+
+    int slot = numero & (janela->capacidade - 1);
+    if (bitJanelaLigado(janela->presentes, slot)) {
+        ligarBitJanela(janela->repetidos, slot);  // Mantém o primeiro; trava depois de entregá-lo
+        return 1;
+    }
+    janela->valores[slot] = valor;
+    ligarBitJanela(janela->presentes, slot);
+    janela->quantidade++;
+    return 1;
+}
+
+// Retira o próximo pacote da sequência, se já tiver chegado; retorna 1 em caso de sucesso
+static inline int retirarDaJanela(JanelaReordenacao *janela, int *valor) {
+    if (janela->travada) return 0;
+    int slot = janela->base & (janela->capacidade - 1);
+    if (!bitJanelaLigado(janela->presentes, slot)) return 0;
+
+    *valor = janela->valores[slot];
+    desligarBitJanela(janela->presentes, slot);
+    if (bitJanelaLigado(janela->repetidos, slot)) {
+        desligarBitJanela(janela->repetidos, slot);
+        janela->travada = 1;
+    }
+    janela->base++;
+    janela->quantidade--;
+    return 1;
+}
+
+static inline int janelaVazia(const JanelaReordenacao *janela) {
+    return janela->quantidade == 0;
+}
+
+//----------------[ Uso em fluxo contínuo (lacunas e descartes) ]----------------
+
+// Diz se 'numero' já está guardado; números fora da janela atual nunca estão
+static inline int numeroNaJanela(const JanelaReordenacao *janela, int numero) {
+    long long deslocamento = (long long)numero - janela->base;
+    if (deslocamento < 0 || deslocamento >= janela->capacidade) return 0;
+    return bitJanelaLigado(janela->presentes, numero & (janela->capacidade - 1));
+}
+
+// Desiste do próximo número (lacuna que não vai mais ser preenchida); retorna 0 se ele estava presente
+static inline int pularLacunaJanela(JanelaReordenacao *janela) {
+    if (bitJanelaLigado(janela->presentes, janela->base & (janela->capacidade - 1))) return 0;
+    janela->base++;
+    return 1;
+}
+
+// Recomeça a sequência em 'novaBase'; só pode ser usada com a janela vazia
+static inline void reposicionarJanela(JanelaReordenacao *janela, int novaBase) {
+    if (janela->quantidade == 0) janela->base = novaBase;
+}
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef LEITOR_RAPIDO_H
+#define LEITOR_RAPIDO_H
+
+/*
+   Leitor rápido de inteiros e palavras para os arquivos de entrada dos exercícios.
+   Substitui os fscanf("%d") dos drivers processar*: o arquivo é mapeado com mmap
+   (ou lido em blocos grandes com fread quando o mmap não está disponível) e os
+   números são convertidos à mão, oito dígitos por vez quando possível (SWAR).
+
+   Uso:
+     LeitorRapido leitor;
+     if (!abrirLeitor(&leitor, "entrada.txt")) { ... }
+     int valor;
+     while (lerInteiro(&leitor, &valor)) { ... }
+     fecharLeitor(&leitor);
+
+   As funções de leitura retornam 1 em caso de sucesso e 0 no fim do arquivo ou
+   quando o próximo token não é do tipo esperado, assim como "fscanf(...) == 1".
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define TAMANHO_BUFFER_LEITOR (1 << 16)  // Bloco lido por fread no modo com buffer
+
+// A conversão de oito dígitos por vez depende da ordem dos bytes (little-endian)
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_WIN32)
+#define LEITOR_SWAR 1
+#else
+#define LEITOR_SWAR 0
+#endif
+
+typedef struct LeitorRapido {
+    const char *dados;  // Bytes disponíveis (arquivo mapeado ou buffer)
+    size_t tamanho;     // Quantidade de bytes válidos em dados
+    size_t posicao;     // Próximo byte a ser consumido
+    FILE *arquivo;      // Usado apenas no modo com buffer
+    char *buffer;       // Buffer do modo com buffer (NULL quando mapeado)
+    int mapeado;        // 1 se dados aponta para o mapeamento do arquivo
+} LeitorRapido;
+
+//----------------[ Abertura e fechamento ]----------------
+
+// Abre o arquivo no modo com buffer (fread em blocos de TAMANHO_BUFFER_LEITOR)
+static inline int abrirLeitorComBuffer(LeitorRapido *leitor, const char *caminho) {
+    memset(leitor, 0, sizeof(*leitor));
+    leitor->arquivo = fopen(caminho, "rb");
+    if (!leitor->arquivo) return 0;
+
+    leitor->buffer = malloc(TAMANHO_BUFFER_LEITOR);
+    if (!leitor->buffer) {
+        fclose(leitor->arquivo);
+        leitor->arquivo = NULL;
+        return 0;
+    }
+    leitor->dados = leitor->buffer;
+    return 1;
+}
+
+// Abre o arquivo mapeando-o na memória; usa o modo com buffer se o mmap não for possível
+static inline int abrirLeitor(LeitorRapido *leitor, const char *caminho) {
+#ifndef _WIN32
+    memset(leitor, 0, sizeof(*leitor));
+    int descritor = open(caminho, O_RDONLY);
+    if (descritor < 0) return 0;
+
+    struct stat informacoes;
+    if (fstat(descritor, &informacoes) == 0 && S_ISREG(informacoes.st_mode) && informacoes.st_size > 0) {
+        void *mapa = mmap(NULL, (size_t)informacoes.st_size, PROT_READ, MAP_PRIVATE, descritor, 0);
+        if (mapa != MAP_FAILED) {
+            madvise(mapa, (size_t)informacoes.st_size, MADV_SEQUENTIAL);
+            close(descritor);
+            leitor->dados = (const char *)mapa;
+            leitor->tamanho = (size_t)informacoes.st_size;
+            leitor->mapeado = 1;
+            return 1;
+        }
+    }
+    close(descritor);
+#endif
+    return abrirLeitorComBuffer(leitor, caminho);
+}
+
+// Mapeia o arquivo numa cópia privada e gravável: o programa pode alterar os bytes
+// sem afetar o arquivo. Não há modo com buffer; retorna 0 se o mmap não for possível.
+static inline int abrirLeitorMapeadoGravavel(LeitorRapido *leitor, const char *caminho) {
+    memset(leitor, 0, sizeof(*leitor));
+#ifndef _WIN32
+    int descritor = open(caminho, O_RDONLY);
+    if (descritor < 0) return 0;
+
+    struct stat informacoes;
+    if (fstat(descritor, &informacoes) == 0 && S_ISREG(informacoes.st_mode) && informacoes.st_size > 0) {
+        void *mapa = mmap(NULL, (size_t)informacoes.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, descritor, 0);
+        if (mapa != MAP_FAILED) {
+            madvise(mapa, (size_t)informacoes.st_size, MADV_SEQUENTIAL);
+            close(descritor);
+            leitor->dados = (const char *)mapa;
+            leitor->tamanho = (size_t)informacoes.st_size;
+            leitor->mapeado = 1;
+            return 1;
+        }
+    }
+    close(descritor);
+#else
+    (void)caminho;
+#endif
+    return 0;
+}
+
+static inline void fecharLeitor(LeitorRapido *leitor) {
+#ifndef _WIN32
+    if (leitor->mapeado) {
+        munmap((void *)leitor->dados, leitor->tamanho);
+    }
+#endif
+    if (leitor->arquivo) fclose(leitor->arquivo);
+    free(leitor->buffer);
+    memset(leitor, 0, sizeof(*leitor));
+}
+
+// Garante o arquivo inteiro em leitor->dados: mapeado quando possível, senão lido de uma vez
+// para a memória. Serve para quem guarda posições do arquivo e volta a elas depois.
+static inline int abrirLeitorCompleto(LeitorRapido *leitor, const char *caminho) {
+    if (!abrirLeitor(leitor, caminho)) return 0;
+    if (leitor->mapeado) return 1;
+
+    size_t capacidade = TAMANHO_BUFFER_LEITOR, tamanho = 0;
+    char *conteudo = NULL;
+    while (1) {
+        char *novo = realloc(conteudo, capacidade);
+        if (!novo) {
+            free(conteudo);
+            fecharLeitor(leitor);
+            return 0;
+        }
+        conteudo = novo;
+        size_t lidos = fread(conteudo + tamanho, 1, capacidade - tamanho, leitor->arquivo);
+        tamanho += lidos;
+        if (tamanho < capacidade) break;
+        capacidade *= 2;
+    }
+    fclose(leitor->arquivo);
+    free(leitor->buffer);
+    leitor->arquivo = NULL;
+    leitor->buffer = conteudo;  // Liberado por fecharLeitor
+    leitor->dados = conteudo;
+    leitor->tamanho = tamanho;
+    leitor->posicao = 0;
+    return 1;
+}
+
+//----------------[ Acesso aos bytes ]----------------
+
+// Lê o próximo bloco do arquivo (modo com buffer); retorna 0 no fim do arquivo
+static inline int recarregarLeitor(LeitorRapido *leitor) {
+    if (!leitor->arquivo) return 0;
+    leitor->tamanho = fread(leitor->buffer, 1, TAMANHO_BUFFER_LEITOR, leitor->arquivo);
+    leitor->posicao = 0;
+    return leitor->tamanho > 0;
+}
+
+// Retorna o próximo byte sem consumi-lo, ou EOF
+static inline int espiarCaractere(LeitorRapido *leitor) {
+    if (leitor->posicao == leitor->tamanho && !recarregarLeitor(leitor)) return EOF;
+    return (unsigned char)leitor->dados[leitor->posicao];
+}
+
+static inline int ehEspaco(int c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+// Pula espaços em branco e retorna o primeiro caractere útil (sem consumi-lo), ou EOF
+static inline int pularEspacos(LeitorRapido *leitor) {
+    int c = espiarCaractere(leitor);
+    while (c != EOF && ehEspaco(c)) {
+        leitor->posicao++;
+        c = espiarCaractere(leitor);
+    }
+    return c;
+}
+
+//----------------[ Conversão de oito dígitos por vez (SWAR) ]----------------
+
+// Verifica se os oito bytes carregados são todos dígitos ASCII
+static inline int ehOitoDigitos(uint64_t bloco) {
+    return (((bloco & 0xF0F0F0F0F0F0F0F0ULL) |
+             (((bloco + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+}
+
+// Converte oito dígitos ASCII (o primeiro no byte menos significativo) em seu valor decimal
+static inline uint32_t converterOitoDigitos(uint64_t bloco) {
+    const uint64_t mascara = 0x000000FF000000FFULL;
+    const uint64_t multiplicador1 = 100 + (1000000ULL << 32);
+    const uint64_t multiplicador2 = 1 + (10000ULL << 32);
+    bloco -= 0x3030303030303030ULL;
+    bloco = (bloco * 10) + (bloco >> 8);  // Pares de dígitos
+    bloco = (((bloco & mascara) * multiplicador1) + (((bloco >> 16) & mascara) * multiplicador2)) >> 32;
+    return (uint32_t)bloco;
+}
+
+//----------------[ Leitura de tokens ]----------------
+
+// Lê um inteiro com sinal opcional (equivalente a fscanf("%lld"))
+static inline int lerInteiro64(LeitorRapido *leitor, long long *valor) {
+    int c = pularEspacos(leitor);
+    if (c == EOF) return 0;
+
+    int negativo = 0;
+    if (c == '-' || c == '+') {
+        negativo = (c == '-');
+        leitor->posicao++;
+        c = espiarCaractere(leitor);
+    }
+    if (c < '0' || c > '9') return 0;
+
+    uint64_t acumulado = 0;
+    while (1) {
+#if LEITOR_SWAR
+        if (leitor->tamanho - leitor->posicao >= 8) {
+            uint64_t bloco;
+            memcpy(&bloco, leitor->dados + leitor->posicao, sizeof(bloco));
+            if (ehOitoDigitos(bloco)) {
+                acumulado = acumulado * 100000000ULL + converterOitoDigitos(bloco);
+                leitor->posicao += 8;
+                continue;
+            }
+        }
+#endif
+        c = espiarCaractere(leitor);
+        if (c < '0' || c > '9') break;
+        acumulado = acumulado * 10 + (uint64_t)(c - '0');
+        leitor->posicao++;
+    }
+
+    *valor = negativo ? (long long)(0 - acumulado) : (long long)acumulado;
+    return 1;
+}
+
+// Lê um inteiro (equivalente a fscanf("%d"))
+static inline int lerInteiro(LeitorRapido *leitor, int *valor) {
+    long long lido;
+    if (!lerInteiro64(leitor, &lido)) return 0;
+    *valor = (int)lido;
+    return 1;
+}
+
+// Lê uma palavra delimitada por espaços (equivalente a fscanf("%s"), mas limitada à capacidade do destino)
+static inline int lerPalavra(LeitorRapido *leitor, char *destino, size_t capacidade) {
+    int c = pularEspacos(leitor);
+    if (c == EOF || capacidade == 0) return 0;
+
+    size_t tamanho = 0;
+    while (c != EOF && !ehEspaco(c)) {
+        if (tamanho + 1 < capacidade) destino[tamanho++] = (char)c;
+        leitor->posicao++;
+        c = espiarCaractere(leitor);
+    }
+    destino[tamanho] = '\0';
+    return 1;
+}
+
+#endif
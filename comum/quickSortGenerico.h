@@ -0,0 +1,204 @@
+#ifndef QUICKSORT_GENERICO_H
+#define QUICKSORT_GENERICO_H
+
+/*
+   QuickSort para registros de qualquer tipo, usando o mesmo motor ajustado do
+   exercício 2 (Hoare com mediana de três, recursão só no lado menor e caso base
+   para intervalos pequenos).
+
+   Em vez de mover os registros durante o particionamento, ordena pares
+   (chave, índice) de 16 bytes: a chave é extraída uma única vez de cada registro
+   e o índice aponta para o registro original. Empates de chave são resolvidos
+   por uma função de desempate opcional e, por fim, pelo índice, então a
+   ordenação resultante é estável.
+
+   Uso típico:
+     int *ordem = malloc(n * sizeof(int));
+     ordenarIndicesPorChave(registros, n, sizeof(Registro), extrairChave, ordem);
+     // registros[ordem[0]], registros[ordem[1]], ... estão em ordem crescente
+     aplicarPermutacao(registros, n, sizeof(Registro), ordem);  // opcional
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LIMITE_INSERCAO_GENERICO 16  // Intervalos até este tamanho usam ordenação por inserção
+
+typedef struct ParChaveIndice {
+    uint64_t chave;  // Chave sem sinal: a ordem dos bits é a ordem dos registros
+    int indice;      // Posição do registro original
+} ParChaveIndice;
+
+// Compara os índices de dois registros com chaves iguais (<0, 0 ou >0, como strcmp)
+typedef int (*FuncaoDesempate)(int indiceA, int indiceB, void *contexto);
+
+//----------------[ Conversão de chaves para uint64_t ]----------------
+
+// Inteiro com sinal: inverte o bit de sinal para que a ordem sem sinal seja a mesma
+static inline uint64_t chaveDeInteiro(long long valor) {
+    return (uint64_t)valor ^ (1ULL << 63);
+}
+
+// Double: positivos ganham o bit de sinal, negativos têm todos os bits invertidos
+static inline uint64_t chaveDeDouble(double valor) {
+    uint64_t bits;
+    memcpy(&bits, &valor, sizeof(bits));
+    return (bits & (1ULL << 63)) ? ~bits : (bits | (1ULL << 63));
+}
+
+// Até oito bytes iniciais de uma string, em ordem big-endian (mesma ordem do strncmp)
+static inline uint64_t chaveDePrefixo(const char *texto, int tamanho) {
+    uint64_t chave = 0;
+    for (int b = 0; b < 8; b++) {
+        chave <<= 8;
+        if (b < tamanho) chave |= (unsigned char)texto[b];
+    }
+    return chave;
+}
+
+//----------------[ Motor de ordenação dos pares ]----------------
+
+static inline int parMenor(const ParChaveIndice *a, const ParChaveIndice *b, FuncaoDesempate desempatar, void *contexto) {
+    if (a->chave != b->chave) return a->chave < b->chave;
+    if (desempatar) {
+        int resultado = desempatar(a->indice, b->indice, contexto);
+        if (resultado != 0) return resultado < 0;
+    }
+    return a->indice < b->indice;
+}
+
+static inline void trocarPares(ParChaveIndice *a, ParChaveIndice *b) {
+    ParChaveIndice temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+static inline void insercaoPares(ParChaveIndice pares[], int baixo, int alto, FuncaoDesempate desempatar, void *contexto) {
+    for (int i = baixo + 1; i <= alto; i++) {
+        ParChaveIndice atual = pares[i];
+        int j = i - 1;
+        while (j >= baixo && parMenor(&atual, &pares[j], desempatar, contexto)) {
+            pares[j + 1] = pares[j];
+            j--;
+        }
+        pares[j + 1] = atual;
+    }
+}
+
+// Partição de Hoare com a mediana de V[n/4], V[n/2] e V[3n/4] levada para a posição inicial
+static inline int particionarPares(ParChaveIndice pares[], int baixo, int alto, FuncaoDesempate desempatar, void *contexto) {
+    int n = alto - baixo + 1;
+    int idx1 = baixo + n / 4, idx2 = baixo + n / 2, idx3 = baixo + 3 * n / 4;
+    int mediana;
+    if (parMenor(&pares[idx1], &pares[idx2], desempatar, contexto)) {
+        if (parMenor(&pares[idx2], &pares[idx3], desempatar, contexto)) mediana = idx2;
+        else mediana = parMenor(&pares[idx1], &pares[idx3], desempatar, contexto) ? idx3 : idx1;
+    } else {
+        if (parMenor(&pares[idx1], &pares[idx3], desempatar, contexto)) mediana = idx1;
+        else mediana = parMenor(&pares[idx2], &pares[idx3], desempatar, contexto) ? idx3 : idx2;
+    }
+    trocarPares(&pares[mediana], &pares[baixo]);
+
+    ParChaveIndice pivo = pares[baixo];
+    int i = baixo - 1;
+    int j = alto + 1;
+    while (1) {
+        do {
+            i++;
+        } while (parMenor(&pares[i], &pivo, desempatar, contexto));
+        do {
+            j--;
+        } while (parMenor(&pivo, &pares[j], desempatar, contexto));
+        if (i >= j) return j;
+        trocarPares(&pares[i], &pares[j]);
+    }
+}
+
+// Ordena pares[baixo..alto]; pilha O(log n) pela recursão apenas no lado menor
+static inline void quickSortPares(ParChaveIndice pares[], int baixo, int alto, FuncaoDesempate desempatar, void *contexto) {
+    while (alto - baixo >= LIMITE_INSERCAO_GENERICO) {
+        int pivo = particionarPares(pares, baixo, alto, desempatar, contexto);
+        if (pivo - baixo < alto - pivo) {
+            quickSortPares(pares, baixo, pivo, desempatar, contexto);
+            baixo = pivo + 1;
+        } else {
+            quickSortPares(pares, pivo + 1, alto, desempatar, contexto);
+            alto = pivo;
+        }
+    }
+    insercaoPares(pares, baixo, alto, desempatar, contexto);
+}
+
+//----------------[ Interface para registros ]----------------
+
+/*
+   Ordena os registros pela chave extraída sem movê-los.
+   Parâmetros:
+     - registros: vetor de 'quantidade' registros com 'tamanhoRegistro' bytes cada.
+     - extrairChave: devolve a chave de um registro (use chaveDeInteiro/chaveDeDouble/chaveDePrefixo).
+     - desempatar, contexto: desempate opcional para chaves iguais (NULL mantém a ordem original).
+     - ordem: recebe os índices dos registros em ordem crescente.
+   Retorna 1 em caso de sucesso e 0 se faltar memória.
+*/
+static inline int ordenarIndicesPorChaveComDesempate(const void *registros, int quantidade, size_t tamanhoRegistro,
+                                                     uint64_t (*extrairChave)(const void *registro),
+                                                     FuncaoDesempate desempatar, void *contexto, int *ordem) {
+    if (quantidade <= 0) return 1;
+    ParChaveIndice *pares = malloc(quantidade * sizeof(ParChaveIndice));
+    if (!pares) return 0;
+
+    const char *base = (const char *)registros;
+    for (int i = 0; i < quantidade; i++) {
+        pares[i].chave = extrairChave(base + (size_t)i * tamanhoRegistro);
+        pares[i].indice = i;
+    }
+    quickSortPares(pares, 0, quantidade - 1, desempatar, contexto);
+    for (int i = 0; i < quantidade; i++) {
+        ordem[i] = pares[i].indice;
+    }
+
+    free(pares);
+    return 1;
+}
+
+static inline int ordenarIndicesPorChave(const void *registros, int quantidade, size_t tamanhoRegistro,
+                                         uint64_t (*extrairChave)(const void *registro), int *ordem) {
+    return ordenarIndicesPorChaveComDesempate(registros, quantidade, tamanhoRegistro, extrairChave, NULL, NULL, ordem);
+}
+
+/*
+   Reorganiza os registros segundo 'ordem' (registros[k] passa a ser o antigo registros[ordem[k]]).
+   Segue os ciclos da permutação, então cada registro é copiado uma única vez.
+   Retorna 1 em caso de sucesso e 0 se faltar memória.
+*/
+static inline int aplicarPermutacao(void *registros, int quantidade, size_t tamanhoRegistro, const int *ordem) {
+    if (quantidade <= 1) return 1;
+    char *base = (char *)registros;
+    char *temp = malloc(tamanhoRegistro);
+    unsigned char *posicionado = calloc(quantidade, 1);
+    if (!temp || !posicionado) {
+        free(temp);
+        free(posicionado);
+        return 0;
+    }
+
+    for (int inicio = 0; inicio < quantidade; inicio++) {
+        if (posicionado[inicio] || ordem[inicio] == inicio) continue;
+        memcpy(temp, base + (size_t)inicio * tamanhoRegistro, tamanhoRegistro);
+        int atual = inicio;
+        while (ordem[atual] != inicio) {
+            memcpy(base + (size_t)atual * tamanhoRegistro, base + (size_t)ordem[atual] * tamanhoRegistro, tamanhoRegistro);
+            posicionado[atual] = 1;
+            atual = ordem[atual];
+        }
+        memcpy(base + (size_t)atual * tamanhoRegistro, temp, tamanhoRegistro);
+        posicionado[atual] = 1;
+    }
+
+    free(temp);
+    free(posicionado);
+    return 1;
+}
+
+#endif
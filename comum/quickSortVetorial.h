@@ -0,0 +1,478 @@
+#ifndef QUICKSORT_VETORIAL_H
+#define QUICKSORT_VETORIAL_H
+
+/*
+   QuickSort para chaves int32, int64 e double com particionamento vetorial.
+
+   O particionamento é feito por valor: os elementos <= pivô vão para a esquerda
+   e os > pivô para a direita. Com AVX-512 cada vetor lido é gravado com dois
+   compress-store (um para cada lado); com AVX2, que não tem compress-store, o
+   vetor é reordenado por uma tabela de permutações e gravado inteiro nas duas
+   pontas. Um vetor de cada ponta é guardado no início, o que sempre deixa pelo
+   menos um vetor livre de cada lado e permite particionar no próprio array.
+
+   O caminho (escalar, AVX2 ou AVX-512) é escolhido em tempo de execução pelo
+   processador, então não é preciso compilar com -mavx2/-mavx512f. Fora de
+   x86 com gcc/clang só existe o caminho escalar.
+
+   Uso:
+     ordenarInt64(ids, quantidade);
+     ordenarDouble(valores, quantidade);
+     ordenarInt32Nivel(chaves, quantidade, NIVEL_ESCALAR);  // força um caminho
+
+   Chaves double não podem ser NaN (a ordem resultante seria indefinida).
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define QUICKSORT_VETORIAL_X86 1
+#include <immintrin.h>
+#else
+#define QUICKSORT_VETORIAL_X86 0
+#endif
+
+#define LIMITE_INSERCAO_VETORIAL 16  // Intervalos até este tamanho usam ordenação por inserção
+#define MAXIMO_LANES_VETORIAL 16     // Maior vetor suportado (16 x int32 no AVX-512)
+
+typedef enum NivelVetorial {
+    NIVEL_ESCALAR = 0,
+    NIVEL_AVX2 = 1,
+    NIVEL_AVX512 = 2
+} NivelVetorial;
+
+static inline const char *nomeNivelVetorial(NivelVetorial nivel) {
+    switch (nivel) {
+        case NIVEL_AVX512: return "avx512";
+        case NIVEL_AVX2: return "avx2";
+        default: return "escalar";
+    }
+}
+
+// Maior nível suportado pelo processador em que o programa está rodando
+static inline NivelVetorial detectarNivelVetorial(void) {
+#if QUICKSORT_VETORIAL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return NIVEL_AVX512;
+    if (__builtin_cpu_supports("avx2")) return NIVEL_AVX2;
+#endif
+    return NIVEL_ESCALAR;
+}
+
+//----------------[ Motor escalar, gerado para cada tipo de chave ]----------------
+
+/*
+   Para cada tipo são gerados:
+     - vaiParaEsquerda: x <= pivô (ou x < pivô no modo estrito)
+     - distribuir: grava elementos soltos no espaço livre [escritaEsq, escritaDir)
+     - particionarEscalar: partição por valor; retorna quantos ficaram à esquerda
+     - insercao, medianaDeTres e o laço principal quickSortVetorial
+   O modo estrito só é usado quando todos os elementos são <= pivô, para separar
+   os iguais ao pivô (que já estão no lugar) e garantir que o intervalo diminua.
+*/
+#define DEFINIR_QUICKSORT_VETORIAL(Tipo, Sufixo)                                                         \
+    typedef size_t (*Particionador##Sufixo)(Tipo v[], size_t n, Tipo pivo, int estrito);                 \
+                                                                                                         \
+    static inline int vaiParaEsquerda##Sufixo(Tipo x, Tipo pivo, int estrito) {                          \
+        return estrito ? (x < pivo) : !(x > pivo);                                                       \
+    }                                                                                                    \
+                                                                                                         \
+    static inline size_t distribuir##Sufixo(Tipo v[], size_t escritaEsq, size_t escritaDir,              \
+                                            const Tipo soltos[], size_t quantidade, Tipo pivo, int estrito) { \
+        for (size_t k = 0; k < quantidade; k++) {                                                        \
+            if (vaiParaEsquerda##Sufixo(soltos[k], pivo, estrito)) v[escritaEsq++] = soltos[k];          \
+            else v[--escritaDir] = soltos[k];                                                            \
+        }                                                                                                \
+        return escritaEsq;                                                                               \
+    }                                                                                                    \
+                                                                                                         \
+    static inline size_t particionarEscalar##Sufixo(Tipo v[], size_t n, Tipo pivo, int estrito) {        \
+        size_t i = 0, j = n;                                                                             \
+        while (1) {                                                                                      \
+            while (i < j && vaiParaEsquerda##Sufixo(v[i], pivo, estrito)) i++;                           \
+            while (i < j && !vaiParaEsquerda##Sufixo(v[j - 1], pivo, estrito)) j--;                      \
+            if (i >= j) return i;                                                                        \
+            Tipo temp = v[i];                                                                            \
+            v[i] = v[j - 1];                                                                             \
+            v[j - 1] = temp;                                                                             \
+            i++;                                                                                         \
+            j--;                                                                                         \
+        }                                                                                                \
+    }                                                                                                    \
+                                                                                                         \
+    static inline void insercao##Sufixo(Tipo v[], size_t n) {                                            \
+        for (size_t i = 1; i < n; i++) {                                                                 \
+            Tipo atual = v[i];                                                                           \
+            size_t j = i;                                                                                \
+            while (j > 0 && v[j - 1] > atual) {                                                          \
+                v[j] = v[j - 1];                                                                         \
+                j--;                                                                                     \
+            }                                                                                            \
+            v[j] = atual;                                                                                \
+        }                                                                                                \
+    }                                                                                                    \
+                                                                                                         \
+    /* Mediana de V[n/4], V[n/2] e V[3n/4], como no exercício 2 */                                       \
+    static inline Tipo medianaDeTres##Sufixo(const Tipo v[], size_t n) {                                 \
+        Tipo a = v[n / 4], b = v[n / 2], c = v[3 * (n / 4)];                                             \
+        if (a < b) return (b < c) ? b : ((a < c) ? c : a);                                               \
+        return (a < c) ? a : ((b < c) ? c : b);                                                          \
+    }                                                                                                    \
+                                                                                                         \
+    /* Pilha O(log n): recursão apenas no lado menor */                                                  \
+    static inline void quickSortVetorial##Sufixo(Tipo v[], size_t n, Particionador##Sufixo particionar) { \
+        while (n > LIMITE_INSERCAO_VETORIAL) {                                                           \
+            Tipo pivo = medianaDeTres##Sufixo(v, n);                                                     \
+            size_t esquerda = particionar(v, n, pivo, 0);                                                \
+            if (esquerda == n) {                                                                         \
+                /* O pivô é o máximo: os iguais a ele vão para o fim e já estão no lugar */              \
+                n = particionar(v, n, pivo, 1);                                                          \
+                continue;                                                                                \
+            }                                                                                            \
+            if (esquerda < n - esquerda) {                                                               \
+                quickSortVetorial##Sufixo(v, esquerda, particionar);                                     \
+                v += esquerda;                                                                           \
+                n -= esquerda;                                                                           \
+            } else {                                                                                     \
+                quickSortVetorial##Sufixo(v + esquerda, n - esquerda, particionar);                      \
+                n = esquerda;                                                                            \
+            }                                                                                            \
+        }                                                                                                \
+        insercao##Sufixo(v, n);                                                                          \
+    }
+
+DEFINIR_QUICKSORT_VETORIAL(int32_t, Int32)
+DEFINIR_QUICKSORT_VETORIAL(int64_t, Int64)
+DEFINIR_QUICKSORT_VETORIAL(double, Double)
+
+#if QUICKSORT_VETORIAL_X86
+
+//----------------[ AVX-512: compress-store ]----------------
+
+/*
+   Todos os particionadores vetoriais seguem o mesmo esquema:
+     1. guardam o primeiro e o último vetor, abrindo um vetor livre em cada ponta;
+     2. leem o próximo vetor do lado com menos espaço livre, o que garante que os
+        dois lados tenham pelo menos um vetor livre antes da gravação;
+     3. gravam os elementos da esquerda em escritaEsq e os da direita logo antes de escritaDir;
+     4. no fim, o resto (< 1 vetor) e os dois vetores guardados são distribuídos no
+        espaço que sobrou entre escritaEsq e escritaDir.
+*/
+
+__attribute__((target("avx512f")))
+static inline size_t particionarAvx512Int32(int32_t v[], size_t n, int32_t pivo, int estrito) {
+    const size_t largura = 16;
+    if (n < 2 * largura) return particionarEscalarInt32(v, n, pivo, estrito);
+
+    int32_t soltos[3 * MAXIMO_LANES_VETORIAL];
+    _mm512_storeu_si512((void *)soltos, _mm512_loadu_si512((const void *)v));
+    _mm512_storeu_si512((void *)(soltos + largura), _mm512_loadu_si512((const void *)(v + n - largura)));
+
+    const __m512i vetorPivo = _mm512_set1_epi32(pivo);
+    size_t leituraEsq = largura, leituraDir = n - largura;
+    size_t escritaEsq = 0, escritaDir = n;
+    while (leituraDir - leituraEsq >= largura) {
+        __m512i x;
+        if (leituraEsq - escritaEsq <= escritaDir - leituraDir) {
+            x = _mm512_loadu_si512((const void *)(v + leituraEsq));
+            leituraEsq += largura;
+        } else {
+            leituraDir -= largura;
+            x = _mm512_loadu_si512((const void *)(v + leituraDir));
+        }
+        __mmask16 esquerda = estrito ? _mm512_cmplt_epi32_mask(x, vetorPivo) : _mm512_cmple_epi32_mask(x, vetorPivo);
+        size_t quantidadeEsq = (size_t)__builtin_popcount((unsigned)esquerda);
+        _mm512_mask_compressstoreu_epi32(v + escritaEsq, esquerda, x);
+        escritaEsq += quantidadeEsq;
+        escritaDir -= largura - quantidadeEsq;
+        _mm512_mask_compressstoreu_epi32(v + escritaDir, (__mmask16)~esquerda, x);
+    }
+
+    size_t resto = leituraDir - leituraEsq;
+    memcpy(soltos + 2 * largura, v + leituraEsq, resto * sizeof(int32_t));
+    return distribuirInt32(v, escritaEsq, escritaDir, soltos, 2 * largura + resto, pivo, estrito);
+}
+
+__attribute__((target("avx512f")))
+static inline size_t particionarAvx512Int64(int64_t v[], size_t n, int64_t pivo, int estrito) {
+    const size_t largura = 8;
+    if (n < 2 * largura) return particionarEscalarInt64(v, n, pivo, estrito);
+
+    int64_t soltos[3 * MAXIMO_LANES_VETORIAL];
+    _mm512_storeu_si512((void *)soltos, _mm512_loadu_si512((const void *)v));
+    _mm512_storeu_si512((void *)(soltos + largura), _mm512_loadu_si512((const void *)(v + n - largura)));
+
+    const __m512i vetorPivo = _mm512_set1_epi64(pivo);
+    size_t leituraEsq = largura, leituraDir = n - largura;
+    size_t escritaEsq = 0, escritaDir = n;
+    while (leituraDir - leituraEsq >= largura) {
+        __m512i x;
+        if (leituraEsq - escritaEsq <= escritaDir - leituraDir) {
+            x = _mm512_loadu_si512((const void *)(v + leituraEsq));
+            leituraEsq += largura;
+        } else {
+            leituraDir -= largura;
+            x = _mm512_loadu_si512((const void *)(v + leituraDir));
+        }
+        __mmask8 esquerda = estrito ? _mm512_cmplt_epi64_mask(x, vetorPivo) : _mm512_cmple_epi64_mask(x, vetorPivo);
+        size_t quantidadeEsq = (size_t)__builtin_popcount((unsigned)esquerda);
+        _mm512_mask_compressstoreu_epi64(v + escritaEsq, esquerda, x);
+        escritaEsq += quantidadeEsq;
+        escritaDir -= largura - quantidadeEsq;
+        _mm512_mask_compressstoreu_epi64(v + escritaDir, (__mmask8)~esquerda, x);
+    }
+
+    size_t resto = leituraDir - leituraEsq;
+    memcpy(soltos + 2 * largura, v + leituraEsq, resto * sizeof(int64_t));
+    return distribuirInt64(v, escritaEsq, escritaDir, soltos, 2 * largura + resto, pivo, estrito);
+}
+
+__attribute__((target("avx512f")))
+static inline size_t particionarAvx512Double(double v[], size_t n, double pivo, int estrito) {
+    const size_t largura = 8;
+    if (n < 2 * largura) return particionarEscalarDouble(v, n, pivo, estrito);
+
+    double soltos[3 * MAXIMO_LANES_VETORIAL];
+    _mm512_storeu_pd(soltos, _mm512_loadu_pd(v));
+    _mm512_storeu_pd(soltos + largura, _mm512_loadu_pd(v + n - largura));
+
+    const __m512d vetorPivo = _mm512_set1_pd(pivo);
+    size_t leituraEsq = largura, leituraDir = n - largura;
+    size_t escritaEsq = 0, escritaDir = n;
+    while (leituraDir - leituraEsq >= largura) {
+        __m512d x;
+        if (leituraEsq - escritaEsq <= escritaDir - leituraDir) {
+            x = _mm512_loadu_pd(v + leituraEsq);
+            leituraEsq += largura;
+        } else {
+            leituraDir -= largura;
+            x = _mm512_loadu_pd(v + leituraDir);
+        }
+        // !(x > pivô) em vez de x <= pivô, igual ao caminho escalar
+        __mmask8 esquerda = estrito ? _mm512_cmp_pd_mask(x, vetorPivo, _CMP_LT_OQ)
+                                    : _mm512_cmp_pd_mask(x, vetorPivo, _CMP_NGT_UQ);
+        size_t quantidadeEsq = (size_t)__builtin_popcount((unsigned)esquerda);
+        _mm512_mask_compressstoreu_pd(v + escritaEsq, esquerda, x);
+        escritaEsq += quantidadeEsq;
+        escritaDir -= largura - quantidadeEsq;
+        _mm512_mask_compressstoreu_pd(v + escritaDir, (__mmask8)~esquerda, x);
+    }
+
+    size_t resto = leituraDir - leituraEsq;
+    memcpy(soltos + 2 * largura, v + leituraEsq, resto * sizeof(double));
+    return distribuirDouble(v, escritaEsq, escritaDir, soltos, 2 * largura + resto, pivo, estrito);
+}
+
+//----------------[ AVX2: tabela de permutações ]----------------
+
+/*
+   Para cada máscara de lanes que vão para a esquerda, a tabela guarda a permutação
+   que coloca essas lanes no início do vetor (em ordem) e as demais no fim.
+   O vetor permutado é gravado inteiro em escritaEsq e em escritaDir - largura;
+   cada ponteiro avança apenas a quantidade de elementos do seu lado.
+   Para chaves de 64 bits cada lane ocupa dois índices de 32 bits.
+*/
+static uint32_t tabelaPermutacao32[256][8];
+static uint32_t tabelaPermutacao64[16][8];
+
+__attribute__((constructor))
+static void montarTabelasPermutacao(void) {
+    for (int mascara = 0; mascara < 256; mascara++) {
+        int posicao = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            if (mascara & (1 << lane)) tabelaPermutacao32[mascara][posicao++] = (uint32_t)lane;
+        }
+        for (int lane = 0; lane < 8; lane++) {
+            if (!(mascara & (1 << lane))) tabelaPermutacao32[mascara][posicao++] = (uint32_t)lane;
+        }
+    }
+    for (int mascara = 0; mascara < 16; mascara++) {
+        int posicao = 0;
+        for (int lane = 0; lane < 4; lane++) {
+            if (mascara & (1 << lane)) {
+                tabelaPermutacao64[mascara][posicao++] = (uint32_t)(2 * lane);
+                tabelaPermutacao64[mascara][posicao++] = (uint32_t)(2 * lane + 1);
+            }
+        }
+        for (int lane = 0; lane < 4; lane++) {
+            if (!(mascara & (1 << lane))) {
+                tabelaPermutacao64[mascara][posicao++] = (uint32_t)(2 * lane);
+                tabelaPermutacao64[mascara][posicao++] = (uint32_t)(2 * lane + 1);
+            }
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static inline size_t particionarAvx2Int32(int32_t v[], size_t n, int32_t pivo, int estrito) {
+    const size_t largura = 8;
+    if (n < 2 * largura) return particionarEscalarInt32(v, n, pivo, estrito);
+
+    int32_t soltos[3 * MAXIMO_LANES_VETORIAL];
+    _mm256_storeu_si256((__m256i *)soltos, _mm256_loadu_si256((const __m256i *)v));
+    _mm256_storeu_si256((__m256i *)(soltos + largura), _mm256_loadu_si256((const __m256i *)(v + n - largura)));
+
+    const __m256i vetorPivo = _mm256_set1_epi32(pivo);
+    size_t leituraEsq = largura, leituraDir = n - largura;
+    size_t escritaEsq = 0, escritaDir = n;
+    while (leituraDir - leituraEsq >= largura) {
+        __m256i x;
+        if (leituraEsq - escritaEsq <= escritaDir - leituraDir) {
+            x = _mm256_loadu_si256((const __m256i *)(v + leituraEsq));
+            leituraEsq += largura;
+        } else {
+            leituraDir -= largura;
+            x = _mm256_loadu_si256((const __m256i *)(v + leituraDir));
+        }
+        // AVX2 só compara com "maior que": x <= pivô é !(x > pivô) e x < pivô é pivô > x
+        int esquerda = estrito
+            ? _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(vetorPivo, x)))
+            : (~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, vetorPivo))) & 0xFF);
+        size_t quantidadeEsq = (size_t)__builtin_popcount((unsigned)esquerda);
+        __m256i permutacao = _mm256_loadu_si256((const __m256i *)tabelaPermutacao32[esquerda]);
+        __m256i ordenado = _mm256_permutevar8x32_epi32(x, permutacao);
+        _mm256_storeu_si256((__m256i *)(v + escritaEsq), ordenado);
+        _mm256_storeu_si256((__m256i *)(v + escritaDir - largura), ordenado);
+        escritaEsq += quantidadeEsq;
+        escritaDir -= largura - quantidadeEsq;
+    }
+
+    size_t resto = leituraDir - leituraEsq;
+    memcpy(soltos + 2 * largura, v + leituraEsq, resto * sizeof(int32_t));
+    return distribuirInt32(v, escritaEsq, escritaDir, soltos, 2 * largura + resto, pivo, estrito);
+}
+
+__attribute__((target("avx2")))
+static inline size_t particionarAvx2Int64(int64_t v[], size_t n, int64_t pivo, int estrito) {
+    const size_t largura = 4;
+    if (n < 2 * largura) return particionarEscalarInt64(v, n, pivo, estrito);
+
+    int64_t soltos[3 * MAXIMO_LANES_VETORIAL];
+    _mm256_storeu_si256((__m256i *)soltos, _mm256_loadu_si256((const __m256i *)v));
+    _mm256_storeu_si256((__m256i *)(soltos + largura), _mm256_loadu_si256((const __m256i *)(v + n - largura)));
+
+    const __m256i vetorPivo = _mm256_set1_epi64x(pivo);
+    size_t leituraEsq = largura, leituraDir = n - largura;
+    size_t escritaEsq = 0, escritaDir = n;
+    while (leituraDir - leituraEsq >= largura) {
+        __m256i x;
+        if (leituraEsq - escritaEsq <= escritaDir - leituraDir) {
+            x = _mm256_loadu_si256((const __m256i *)(v + leituraEsq));
+            leituraEsq += largura;
+        } else {
+            leituraDir -= largura;
+            x = _mm256_loadu_si256((const __m256i *)(v + leituraDir));
+        }
+        int esquerda = estrito
+            ? _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(vetorPivo, x)))
+            : (~_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(x, vetorPivo))) & 0xF);
+        size_t quantidadeEsq = (size_t)__builtin_popcount((unsigned)esquerda);
+        __m256i permutacao = _mm256_loadu_si256((const __m256i *)tabelaPermutacao64[esquerda]);
+        __m256i ordenado = _mm256_permutevar8x32_epi32(x, permutacao);
+        _mm256_storeu_si256((__m256i *)(v + escritaEsq), ordenado);
+        _mm256_storeu_si256((__m256i *)(v + escritaDir - largura), ordenado);
+        escritaEsq += quantidadeEsq;
+        escritaDir -= largura - quantidadeEsq;
+    }
+
+    size_t resto = leituraDir - leituraEsq;
+    memcpy(soltos + 2 * largura, v + leituraEsq, resto * sizeof(int64_t));
+    return distribuirInt64(v, escritaEsq, escritaDir, soltos, 2 * largura + resto, pivo, estrito);
+}
+
+__attribute__((target("avx2")))
+static inline size_t particionarAvx2Double(double v[], size_t n, double pivo, int estrito) {
+    const size_t largura = 4;
+    if (n < 2 * largura) return particionarEscalarDouble(v, n, pivo, estrito);
+
+    double soltos[3 * MAXIMO_LANES_VETORIAL];
+    _mm256_storeu_pd(soltos, _mm256_loadu_pd(v));
+    _mm256_storeu_pd(soltos + largura, _mm256_loadu_pd(v + n - largura));
+
+    const __m256d vetorPivo = _mm256_set1_pd(pivo);
+    size_t leituraEsq = largura, leituraDir = n - largura;
+    size_t escritaEsq = 0, escritaDir = n;
+    while (leituraDir - leituraEsq >= largura) {
+        __m256d x;
+        if (leituraEsq - escritaEsq <= escritaDir - leituraDir) {
+            x = _mm256_loadu_pd(v + leituraEsq);
+            leituraEsq += largura;
+        } else {
+            leituraDir -= largura;
+            x = _mm256_loadu_pd(v + leituraDir);
+        }
+        int esquerda = _mm256_movemask_pd(estrito ? _mm256_cmp_pd(x, vetorPivo, _CMP_LT_OQ)
+                                                  : _mm256_cmp_pd(x, vetorPivo, _CMP_NGT_UQ));
+        size_t quantidadeEsq = (size_t)__builtin_popcount((unsigned)esquerda);
+        __m256i permutacao = _mm256_loadu_si256((const __m256i *)tabelaPermutacao64[esquerda]);
+        __m256d ordenado = _mm256_castsi256_pd(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(x), permutacao));
+        _mm256_storeu_pd(v + escritaEsq, ordenado);
+        _mm256_storeu_pd(v + escritaDir - largura, ordenado);
+        escritaEsq += quantidadeEsq;
+        escritaDir -= largura - quantidadeEsq;
+    }
+
+    size_t resto = leituraDir - leituraEsq;
+    memcpy(soltos + 2 * largura, v + leituraEsq, resto * sizeof(double));
+    return distribuirDouble(v, escritaEsq, escritaDir, soltos, 2 * largura + resto, pivo, estrito);
+}
+
+#endif  // QUICKSORT_VETORIAL_X86
+
+//----------------[ Interface com escolha do caminho em tempo de execução ]----------------
+
+// Usa o nível pedido se o processador o suportar; caso contrário, o maior disponível abaixo dele
+static inline NivelVetorial limitarNivelVetorial(NivelVetorial nivel) {
+    NivelVetorial disponivel = detectarNivelVetorial();
+    return nivel < disponivel ? nivel : disponivel;
+}
+
+static inline void ordenarInt32Nivel(int32_t v[], size_t n, NivelVetorial nivel) {
+    ParticionadorInt32 particionar = particionarEscalarInt32;
+#if QUICKSORT_VETORIAL_X86
+    switch (limitarNivelVetorial(nivel)) {
+        case NIVEL_AVX512: particionar = particionarAvx512Int32; break;
+        case NIVEL_AVX2: particionar = particionarAvx2Int32; break;
+        default: break;
+    }
+#else
+    (void)nivel;
+#endif
+    quickSortVetorialInt32(v, n, particionar);
+}
+
+static inline void ordenarInt64Nivel(int64_t v[], size_t n, NivelVetorial nivel) {
+    ParticionadorInt64 particionar = particionarEscalarInt64;
+#if QUICKSORT_VETORIAL_X86
+    switch (limitarNivelVetorial(nivel)) {
+        case NIVEL_AVX512: particionar = particionarAvx512Int64; break;
+        case NIVEL_AVX2: particionar = particionarAvx2Int64; break;
+        default: break;
+    }
+#else
+    (void)nivel;
+#endif
+    quickSortVetorialInt64(v, n, particionar);
+}
+
+static inline void ordenarDoubleNivel(double v[], size_t n, NivelVetorial nivel) {
+    ParticionadorDouble particionar = particionarEscalarDouble;
+#if QUICKSORT_VETORIAL_X86
+    switch (limitarNivelVetorial(nivel)) {
+        case NIVEL_AVX512: particionar = particionarAvx512Double; break;
+        case NIVEL_AVX2: particionar = particionarAvx2Double; break;
+        default: break;
+    }
+#else
+    (void)nivel;
+#endif
+    quickSortVetorialDouble(v, n, particionar);
+}
+
+static inline void ordenarInt32(int32_t v[], size_t n) { ordenarInt32Nivel(v, n, NIVEL_AVX512); }
+static inline void ordenarInt64(int64_t v[], size_t n) { ordenarInt64Nivel(v, n, NIVEL_AVX512); }
+static inline void ordenarDouble(double v[], size_t n) { ordenarDoubleNivel(v, n, NIVEL_AVX512); }
+
+#endif